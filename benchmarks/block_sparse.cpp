@@ -0,0 +1,87 @@
+#include "counters.hpp"
+
+#include <tt/core/float.hpp>
+#include <tt/operators/full.hpp>
+#include <tt/operators/matmul.hpp>
+#include <tt/operators/to_block_sparse.hpp>
+#include <tt/operators/to_layout.hpp>
+#include <tt/operators/zeros.hpp>
+
+namespace {
+
+constexpr std::size_t extent = 512;
+
+// lhs keeps one tile in every state.range(0) along each row of tiles, so the
+// stored fraction is 1 / state.range(0)
+template <class T, class TLayout>
+auto block_sparse_lhs(benchmark::State &state) {
+  constexpr auto dtype = tt::value_v<tt::dtypes, T>;
+  const auto period = static_cast<std::size_t>(state.range(0));
+  const auto dense = tt::zeros<dtype>(extent, extent);
+  const auto dense_view = tt::borrow(dense);
+
+  for (std::size_t row = 0; row < extent; ++row) {
+    for (std::size_t col = 0; col < extent; ++col) {
+      const auto tile = row / TLayout::tile_height + col / TLayout::tile_width;
+
+      if (tile % period == 0) {
+        dense_view(row, col) = T(1);
+      }
+    }
+  }
+
+  return dense | tt::to_layout_view<TLayout>{} | tt::to_block_sparse();
+}
+
+template <class T, class TLayout, class TRhsLayout>
+auto matmul_block_sparse(benchmark::State &state) -> void {
+  constexpr auto dtype = tt::value_v<tt::dtypes, T>;
+  const auto lhs = block_sparse_lhs<T, TLayout>(state);
+  const auto rhs =
+      tt::full<dtype>(1, extent, extent) | tt::to_layout_view<TRhsLayout>{};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tt::matmul(lhs, rhs));
+  }
+
+  const auto stored = lhs.stored_tiles() * TLayout::tile_size;
+
+  tt::benchmarks::set_bytes(state, (stored + 2 * extent * extent) * sizeof(T));
+  tt::benchmarks::set_flops(state, 2 * stored * extent);
+}
+
+template <class T>
+auto to_block_sparse(benchmark::State &state) -> void {
+  constexpr auto dtype = tt::value_v<tt::dtypes, T>;
+  const auto input = tt::full<dtype>(1, extent, extent) | tt::to_tiled<32>();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(input | tt::to_block_sparse());
+  }
+
+  tt::benchmarks::set_bytes(state, 2 * extent * extent * sizeof(T));
+}
+
+constexpr std::int64_t min_period = 1;
+constexpr std::int64_t max_period = 16;
+
+using tiled_32 = tt::layout_right_tiled<32>;
+
+} // namespace
+
+BENCHMARK_TEMPLATE(matmul_block_sparse, tt::Float32, tiled_32, tiled_32)
+    ->RangeMultiplier(2)
+    ->Range(min_period, max_period);
+BENCHMARK_TEMPLATE(matmul_block_sparse, tt::Float32, tiled_32, tt::RowMajor)
+    ->RangeMultiplier(2)
+    ->Range(min_period, max_period);
+BENCHMARK_TEMPLATE(matmul_block_sparse, tt::Float32, tt::TiledFaces,
+                   tt::TiledFaces)
+    ->RangeMultiplier(2)
+    ->Range(min_period, max_period);
+BENCHMARK_TEMPLATE(matmul_block_sparse, tt::BFloat16, tiled_32, tiled_32)
+    ->RangeMultiplier(2)
+    ->Range(min_period, max_period);
+
+BENCHMARK_TEMPLATE(to_block_sparse, tt::Float32);
+BENCHMARK_TEMPLATE(to_block_sparse, tt::BFloat16);
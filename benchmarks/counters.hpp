@@ -0,0 +1,21 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+namespace tt::benchmarks {
+
+// reports bytes read and written per iteration as a rate
+inline auto set_bytes(benchmark::State &state, std::size_t bytes) -> void {
+  state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations()) *
+                          static_cast<std::int64_t>(bytes));
+}
+
+// reports arithmetic operations per iteration as a rate
+inline auto set_flops(benchmark::State &state, std::size_t flops) -> void {
+  state.counters["FLOP/s"] = benchmark::Counter(
+      static_cast<double>(flops), benchmark::Counter::kIsIterationInvariantRate);
+}
+
+} // namespace tt::benchmarks
@@ -0,0 +1,78 @@
+#include "counters.hpp"
+
+#include <tt/core/float.hpp>
+#include <tt/core/int.hpp>
+#include <tt/operators/arange.hpp>
+#include <tt/operators/empty.hpp>
+#include <tt/operators/full.hpp>
+#include <tt/operators/zeros.hpp>
+
+namespace {
+
+template <class T>
+auto empty(benchmark::State &state) -> void {
+  constexpr auto dtype = tt::value_v<tt::dtypes, T>;
+  const auto size = static_cast<std::size_t>(state.range(0));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tt::empty<dtype>(size));
+  }
+}
+
+template <class T>
+auto full(benchmark::State &state) -> void {
+  constexpr auto dtype = tt::value_v<tt::dtypes, T>;
+  const auto size = static_cast<std::size_t>(state.range(0));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tt::full<dtype>(1, size));
+  }
+
+  tt::benchmarks::set_bytes(state, size * sizeof(T));
+}
+
+template <class T>
+auto zeros(benchmark::State &state) -> void {
+  constexpr auto dtype = tt::value_v<tt::dtypes, T>;
+  const auto size = static_cast<std::size_t>(state.range(0));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tt::zeros<dtype>(size));
+  }
+}
+
+template <class T>
+auto arange(benchmark::State &state) -> void {
+  constexpr auto dtype = tt::value_v<tt::dtypes, T>;
+  const auto size = static_cast<std::int64_t>(state.range(0));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tt::arange<dtype>(size));
+  }
+
+  tt::benchmarks::set_bytes(state, size * sizeof(T));
+}
+
+constexpr std::int64_t min_size = 1 << 10;
+constexpr std::int64_t max_size = 1 << 24;
+
+} // namespace
+
+BENCHMARK_TEMPLATE(empty, tt::Float32)->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(empty, tt::Float64)->Range(min_size, max_size);
+
+BENCHMARK_TEMPLATE(full, tt::Float32)->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(full, tt::Float64)->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(full, tt::BFloat16)->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(full, tt::Int32)->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(full, tt::UInt8)->Range(min_size, max_size);
+
+BENCHMARK_TEMPLATE(zeros, tt::Float32)->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(zeros, tt::Float64)->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(zeros, tt::BFloat16)->Range(min_size, max_size);
+
+BENCHMARK_TEMPLATE(arange, tt::Float32)->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(arange, tt::Float64)->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(arange, tt::BFloat16)->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(arange, tt::Int32)->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(arange, tt::Int64)->Range(min_size, max_size);
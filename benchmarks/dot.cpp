@@ -0,0 +1,33 @@
+#include "counters.hpp"
+
+#include <tt/core/float.hpp>
+#include <tt/core/int.hpp>
+#include <tt/operators/dot.hpp>
+#include <tt/operators/full.hpp>
+
+namespace {
+
+template <class T>
+auto dot(benchmark::State &state) -> void {
+  constexpr auto dtype = tt::value_v<tt::dtypes, T>;
+  const auto size = static_cast<std::size_t>(state.range(0));
+  const auto lhs = tt::full<dtype>(1, size);
+  const auto rhs = tt::full<dtype>(1, size);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tt::dot(lhs, rhs));
+  }
+
+  tt::benchmarks::set_bytes(state, 2 * size * sizeof(T));
+  tt::benchmarks::set_flops(state, 2 * size);
+}
+
+constexpr std::int64_t min_size = 1 << 10;
+constexpr std::int64_t max_size = 1 << 24;
+
+} // namespace
+
+BENCHMARK_TEMPLATE(dot, tt::Float32)->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(dot, tt::Float64)->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(dot, tt::BFloat16)->Range(min_size, max_size);
+BENCHMARK_TEMPLATE(dot, tt::Int32)->Range(min_size, max_size);
@@ -0,0 +1,66 @@
+#include "counters.hpp"
+
+#include <tt/operators/dot.hpp>
+#include <tt/operators/full.hpp>
+#include <tt/operators/matmul.hpp>
+
+namespace {
+
+using three = tt::size_constant<3>;
+using four = tt::size_constant<4>;
+
+// per-point products of a 4x4 transform, on the heap and held by value
+auto matmul_4x4(benchmark::State &state) -> void {
+  const auto lhs = tt::full(1.f, four{}, four{});
+  const auto rhs = tt::full(1.f, four{}, four{});
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tt::matmul(lhs, rhs));
+  }
+
+  tt::benchmarks::set_flops(state, 2 * 4 * 4 * 4);
+}
+
+auto fixed_matmul_4x4(benchmark::State &state) -> void {
+  auto lhs = tt::fixed::full(1.f, four{}, four{});
+  auto rhs = tt::fixed::full(1.f, four{}, four{});
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs);
+    benchmark::DoNotOptimize(rhs);
+    benchmark::DoNotOptimize(tt::matmul(lhs, rhs));
+  }
+
+  tt::benchmarks::set_flops(state, 2 * 4 * 4 * 4);
+}
+
+auto dot_3(benchmark::State &state) -> void {
+  const auto lhs = tt::full(1.f, three{});
+  const auto rhs = tt::full(1.f, three{});
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tt::dot(lhs, rhs));
+  }
+
+  tt::benchmarks::set_flops(state, 2 * 3);
+}
+
+auto fixed_dot_3(benchmark::State &state) -> void {
+  auto lhs = tt::fixed::full(1.f, three{});
+  auto rhs = tt::fixed::full(1.f, three{});
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs);
+    benchmark::DoNotOptimize(rhs);
+    benchmark::DoNotOptimize(tt::dot(lhs, rhs));
+  }
+
+  tt::benchmarks::set_flops(state, 2 * 3);
+}
+
+} // namespace
+
+BENCHMARK(matmul_4x4);
+BENCHMARK(fixed_matmul_4x4);
+BENCHMARK(dot_3);
+BENCHMARK(fixed_dot_3);
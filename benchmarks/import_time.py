@@ -0,0 +1,62 @@
+import argparse
+import importlib.util
+import json
+import os
+import statistics
+import subprocess
+import sys
+
+# imports tt in a fresh interpreter, so that nothing is cached between runs
+IMPORT_SCRIPT = """
+import time
+start = time.perf_counter()
+import tt
+print(time.perf_counter() - start)
+"""
+
+
+def import_seconds():
+    output = subprocess.run(
+        [sys.executable, "-c", IMPORT_SCRIPT],
+        check=True,
+        capture_output=True,
+        text=True,
+    ).stdout
+
+    return float(output)
+
+
+def extension_bytes():
+    spec = importlib.util.find_spec("tt._tt")
+
+    return os.path.getsize(spec.origin)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="measure the import time of tt and the size of its extension"
+    )
+    parser.add_argument("--repeat", type=int, default=10)
+    args = parser.parse_args()
+
+    # the first import also compiles bytecode and warms the page cache
+    import_seconds()
+    seconds = [import_seconds() for _ in range(args.repeat)]
+
+    print(
+        json.dumps(
+            {
+                "import_ms": {
+                    "min": 1e3 * min(seconds),
+                    "median": 1e3 * statistics.median(seconds),
+                    "max": 1e3 * max(seconds),
+                },
+                "extension_bytes": extension_bytes(),
+            },
+            indent=2,
+        )
+    )
+
+
+if __name__ == "__main__":
+    main()
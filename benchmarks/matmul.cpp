@@ -0,0 +1,109 @@
+#include "counters.hpp"
+
+#include <tt/core/float.hpp>
+#include <tt/core/int.hpp>
+#include <tt/operators/full.hpp>
+#include <tt/operators/matmul.hpp>
+#include <tt/operators/matmul_out_of_core.hpp>
+#include <tt/operators/to_layout.hpp>
+
+namespace {
+
+// multiplies square matrices, each operand in its own layout
+template <class T, class TLhsLayout, class TRhsLayout>
+auto matmul(benchmark::State &state) -> void {
+  constexpr auto dtype = tt::value_v<tt::dtypes, T>;
+  const auto extent = static_cast<std::size_t>(state.range(0));
+  const auto lhs =
+      tt::full<dtype>(1, extent, extent) | tt::to_layout_view<TLhsLayout>{};
+  const auto rhs =
+      tt::full<dtype>(1, extent, extent) | tt::to_layout_view<TRhsLayout>{};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tt::matmul(lhs, rhs));
+  }
+
+  tt::benchmarks::set_bytes(state, 3 * extent * extent * sizeof(T));
+  tt::benchmarks::set_flops(state, 2 * extent * extent * extent);
+}
+
+// same product written into one result for every iteration instead of a new
+// one, as e.g. a training loop would
+template <class T, class TLayout>
+auto matmul_out(benchmark::State &state) -> void {
+  constexpr auto dtype = tt::value_v<tt::dtypes, T>;
+  const auto extent = static_cast<std::size_t>(state.range(0));
+  const auto lhs =
+      tt::full<dtype>(1, extent, extent) | tt::to_layout_view<TLayout>{};
+  const auto rhs =
+      tt::full<dtype>(1, extent, extent) | tt::to_layout_view<TLayout>{};
+  const auto result = tt::matmul(lhs, rhs);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tt::matmul_out(result, lhs, rhs));
+  }
+
+  tt::benchmarks::set_bytes(state, 3 * extent * extent * sizeof(T));
+  tt::benchmarks::set_flops(state, 2 * extent * extent * extent);
+}
+
+// same product a panel of rows of tiles at a time under a memory budget, here
+// of operands in memory, which prices the panels against tt::matmul_out
+auto matmul_out_of_core(benchmark::State &state) -> void {
+  const auto extent = static_cast<std::size_t>(state.range(0));
+  const auto budget = static_cast<std::size_t>(state.range(1));
+  const auto lhs = tt::full(1.f, extent, extent) | tt::to_tiled();
+  const auto rhs = tt::full(1.f, extent, extent) | tt::to_tiled();
+  const auto result = tt::matmul(lhs, rhs);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        tt::matmul_out_of_core(result, lhs, rhs, budget));
+  }
+
+  tt::benchmarks::set_bytes(state, 3 * extent * extent * sizeof(float));
+  tt::benchmarks::set_flops(state, 2 * extent * extent * extent);
+}
+
+constexpr std::int64_t min_extent = 32;
+constexpr std::int64_t max_extent = 512;
+
+} // namespace
+
+#define TT_MATMUL_BENCHMARKS(T)                                               \
+  BENCHMARK_TEMPLATE(matmul, T, tt::RowMajor, tt::RowMajor)                   \
+      ->RangeMultiplier(2)                                                    \
+      ->Range(min_extent, max_extent);                                        \
+  BENCHMARK_TEMPLATE(matmul, T, tt::RowMajor, tt::ColMajor)                   \
+      ->RangeMultiplier(2)                                                    \
+      ->Range(min_extent, max_extent);                                        \
+  BENCHMARK_TEMPLATE(matmul, T, tt::ColMajor, tt::ColMajor)                   \
+      ->RangeMultiplier(2)                                                    \
+      ->Range(min_extent, max_extent);                                        \
+  BENCHMARK_TEMPLATE(matmul, T, tt::Tiled, tt::Tiled)                         \
+      ->RangeMultiplier(2)                                                    \
+      ->Range(min_extent, max_extent);                                        \
+  BENCHMARK_TEMPLATE(matmul, T, tt::TiledFaces, tt::TiledFaces)               \
+      ->RangeMultiplier(2)                                                    \
+      ->Range(min_extent, max_extent);                                        \
+  BENCHMARK_TEMPLATE(matmul, T, tt::Tiled, tt::RowMajor)                      \
+      ->RangeMultiplier(2)                                                    \
+      ->Range(min_extent, max_extent);                                        \
+  BENCHMARK_TEMPLATE(matmul, T, tt::RowMajor, tt::Tiled)                      \
+      ->RangeMultiplier(2)                                                    \
+      ->Range(min_extent, max_extent);                                        \
+  BENCHMARK_TEMPLATE(matmul_out, T, tt::RowMajor)                             \
+      ->RangeMultiplier(2)                                                    \
+      ->Range(min_extent, max_extent);                                        \
+  BENCHMARK_TEMPLATE(matmul_out, T, tt::Tiled)                                \
+      ->RangeMultiplier(2)                                                    \
+      ->Range(min_extent, max_extent)
+
+TT_MATMUL_BENCHMARKS(tt::Float32);
+TT_MATMUL_BENCHMARKS(tt::Float64);
+TT_MATMUL_BENCHMARKS(tt::BFloat16);
+TT_MATMUL_BENCHMARKS(tt::Int32);
+
+BENCHMARK(matmul_out_of_core)
+    ->ArgsProduct({{512}, {std::int64_t{1} << 16, std::int64_t{1} << 20,
+                           std::int64_t{1} << 26}});
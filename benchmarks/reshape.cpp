@@ -0,0 +1,28 @@
+#include "counters.hpp"
+
+#include <tt/core/float.hpp>
+#include <tt/operators/full.hpp>
+#include <tt/operators/reshape.hpp>
+#include <tt/operators/to_layout.hpp>
+
+namespace {
+
+// reshapes a batch of matrices into one matrix, which only builds a mapping
+template <class T, class TLayout>
+auto reshape(benchmark::State &state) -> void {
+  constexpr auto dtype = tt::value_v<tt::dtypes, T>;
+  const auto extent = static_cast<std::size_t>(state.range(0));
+  const auto input =
+      tt::full<dtype>(1, extent, extent, extent) | tt::to_layout_view<TLayout>{};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(input | tt::reshape(extent * extent, extent));
+  }
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(reshape, tt::Float32, tt::RowMajor)->Arg(64);
+BENCHMARK_TEMPLATE(reshape, tt::Float32, tt::ColMajor)->Arg(64);
+BENCHMARK_TEMPLATE(reshape, tt::Float32, tt::Tiled)->Arg(64);
+BENCHMARK_TEMPLATE(reshape, tt::Float32, tt::TiledFaces)->Arg(64);
@@ -0,0 +1,71 @@
+#include "counters.hpp"
+
+#include <tt/operators/full.hpp>
+#include <tt/operators/matmul.hpp>
+#include <tt/operators/to_sparse.hpp>
+#include <tt/operators/zeros.hpp>
+
+namespace {
+
+// one element in every 1000, with every 64th row holding a hundred times as
+// many to show the balance of the row partitioning
+auto sparse_matrix(std::size_t extent) {
+  const auto dense = tt::zeros(extent, extent);
+  const auto dense_view = tt::borrow(dense);
+
+  for (std::size_t row = 0; row < extent; ++row) {
+    const std::size_t period = row % 64 == 0 ? 10 : 1000;
+
+    for (std::size_t col = row % period; col < extent; col += period) {
+      dense_view(row, col) = 1.f;
+    }
+  }
+
+  return dense | tt::to_csr();
+}
+
+auto spmv(benchmark::State &state) -> void {
+  const auto extent = static_cast<std::size_t>(state.range(0));
+  const auto lhs = sparse_matrix(extent);
+  const auto rhs = tt::full(1.f, extent);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tt::matmul(lhs, rhs));
+  }
+
+  tt::benchmarks::set_flops(state, 2 * lhs.nnz());
+}
+
+auto spmm(benchmark::State &state) -> void {
+  constexpr std::size_t cols = 64;
+
+  const auto extent = static_cast<std::size_t>(state.range(0));
+  const auto lhs = sparse_matrix(extent);
+  const auto rhs = tt::full(1.f, extent, cols);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tt::matmul(lhs, rhs));
+  }
+
+  tt::benchmarks::set_flops(state, 2 * lhs.nnz() * cols);
+}
+
+auto to_csr(benchmark::State &state) -> void {
+  const auto extent = static_cast<std::size_t>(state.range(0));
+  const auto input = sparse_matrix(extent) | tt::to_row_major();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(input | tt::to_csr());
+  }
+
+  tt::benchmarks::set_bytes(state, extent * extent * sizeof(float));
+}
+
+constexpr std::int64_t min_extent = 1 << 10;
+constexpr std::int64_t max_extent = 1 << 14;
+
+} // namespace
+
+BENCHMARK(spmv)->RangeMultiplier(4)->Range(min_extent, max_extent);
+BENCHMARK(spmm)->RangeMultiplier(4)->Range(min_extent, max_extent);
+BENCHMARK(to_csr)->RangeMultiplier(4)->Range(min_extent, max_extent);
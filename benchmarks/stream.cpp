@@ -0,0 +1,66 @@
+#include "counters.hpp"
+
+#include <tt/operators/full.hpp>
+#include <tt/operators/stream_tiles.hpp>
+#include <tt/operators/to_layout.hpp>
+
+#include <numeric>
+#include <vector>
+
+namespace {
+
+// sums a tile into the entry of its coordinates, standing in for a kernel
+// that reads each tile of its input once
+template <class TTile>
+auto sum_tile(std::vector<float> &sums, std::size_t tile_cols,
+              const TTile &tile) -> void {
+  sums[tile.row / TTile::height * tile_cols + tile.col / TTile::width] =
+      std::accumulate(tile.begin(), tile.end(), 0.f);
+}
+
+// tiles a square matrix and then consumes its tiles
+auto tiles_materialized(benchmark::State &state) -> void {
+  const auto extent = static_cast<std::size_t>(state.range(0));
+  const auto input = tt::full(1.f, extent, extent);
+  const auto tile_cols = extent / tt::Tiled::tile_width;
+  std::vector<float> sums(tile_cols * tile_cols);
+
+  for (auto _ : state) {
+    const auto tiled = input | tt::to_tiled();
+
+    tt::parallel_for_each_tile(tiled, [&](const auto &tile) {
+      sum_tile(sums, tile_cols, tile);
+    });
+    benchmark::DoNotOptimize(sums.data());
+  }
+
+  tt::benchmarks::set_bytes(state, extent * extent * sizeof(float));
+}
+
+// consumes the tiles of a square matrix as they are tiled, without the tiled
+// matrix
+auto tiles_streamed(benchmark::State &state) -> void {
+  const auto extent = static_cast<std::size_t>(state.range(0));
+  const auto input = tt::full(1.f, extent, extent);
+  const auto tile_cols = extent / tt::Tiled::tile_width;
+  std::vector<float> sums(tile_cols * tile_cols);
+
+  for (auto _ : state) {
+    tt::stream_tiles<tt::Tiled>(input, [&](const auto &tile) {
+      sum_tile(sums, tile_cols, tile);
+    });
+    benchmark::DoNotOptimize(sums.data());
+  }
+
+  tt::benchmarks::set_bytes(state, extent * extent * sizeof(float));
+}
+
+constexpr std::int64_t min_extent = 64;
+constexpr std::int64_t max_extent = 4096;
+
+} // namespace
+
+BENCHMARK(tiles_materialized)
+    ->RangeMultiplier(4)
+    ->Range(min_extent, max_extent);
+BENCHMARK(tiles_streamed)->RangeMultiplier(4)->Range(min_extent, max_extent);
@@ -0,0 +1,114 @@
+#include "counters.hpp"
+
+#include <tt/core/float.hpp>
+#include <tt/core/int.hpp>
+#include <tt/operators/full.hpp>
+#include <tt/operators/to_layout.hpp>
+#include <tt/operators/to_layout_inplace.hpp>
+
+namespace {
+
+// converts a square matrix from one layout to another
+template <class T, class TInputLayout, class TOutputLayout>
+auto to_layout(benchmark::State &state) -> void {
+  constexpr auto dtype = tt::value_v<tt::dtypes, T>;
+  const auto extent = static_cast<std::size_t>(state.range(0));
+  const auto input = tt::full<dtype>(1, extent, extent) |
+                     tt::to_layout_view<TInputLayout>{};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(input | tt::to_layout_view<TOutputLayout>{});
+  }
+
+  tt::benchmarks::set_bytes(state, 2 * extent * extent * sizeof(T));
+}
+
+// converts a batch of matrices, which tiled layouts store one after another
+template <class T, class TInputLayout, class TOutputLayout>
+auto to_layout_batched(benchmark::State &state) -> void {
+  constexpr auto dtype = tt::value_v<tt::dtypes, T>;
+  const auto batch = static_cast<std::size_t>(state.range(0));
+  const auto extent = static_cast<std::size_t>(state.range(1));
+  const auto input = tt::full<dtype>(1, batch, extent, extent) |
+                     tt::to_layout_view<TInputLayout>{};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(input | tt::to_layout_view<TOutputLayout>{});
+  }
+
+  tt::benchmarks::set_bytes(state, 2 * batch * extent * extent * sizeof(T));
+}
+
+// converts the same row-major matrix every iteration, as with weights, which
+// the layout cache answers after the first conversion
+auto to_tiled_cached(benchmark::State &state) -> void {
+  const auto extent = static_cast<std::size_t>(state.range(0));
+  const auto input = tt::full(1.f, extent, extent);
+  auto &cache = tt::get_layout_cache();
+
+  cache.enable();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(input | tt::to_tiled());
+  }
+
+  cache.clear();
+  cache.disable();
+}
+
+// tiles a square matrix within its own buffer and restores it, so that every
+// iteration starts from row-major
+auto to_tiled_inplace(benchmark::State &state) -> void {
+  const auto extent = static_cast<std::size_t>(state.range(0));
+  const auto input = tt::full(1.f, extent, extent);
+
+  for (auto _ : state) {
+    const auto tiled = tt::to_tiled_(input);
+
+    benchmark::DoNotOptimize(tt::to_row_major_(tiled));
+  }
+
+  tt::benchmarks::set_bytes(state, 4 * extent * extent * sizeof(float));
+}
+
+constexpr std::int64_t min_extent = 64;
+constexpr std::int64_t max_extent = 4096;
+
+} // namespace
+
+#define TT_TO_LAYOUT_BENCHMARKS(T)                                            \
+  BENCHMARK_TEMPLATE(to_layout, T, tt::RowMajor, tt::Tiled)                   \
+      ->RangeMultiplier(4)                                                    \
+      ->Range(min_extent, max_extent);                                        \
+  BENCHMARK_TEMPLATE(to_layout, T, tt::Tiled, tt::RowMajor)                   \
+      ->RangeMultiplier(4)                                                    \
+      ->Range(min_extent, max_extent);                                        \
+  BENCHMARK_TEMPLATE(to_layout, T, tt::RowMajor, tt::layout_right_tiled<32>)  \
+      ->RangeMultiplier(4)                                                    \
+      ->Range(min_extent, max_extent);                                        \
+  BENCHMARK_TEMPLATE(to_layout, T, tt::layout_right_tiled<32>, tt::RowMajor)  \
+      ->RangeMultiplier(4)                                                    \
+      ->Range(min_extent, max_extent);                                        \
+  BENCHMARK_TEMPLATE(to_layout, T, tt::RowMajor, tt::TiledFaces)              \
+      ->RangeMultiplier(4)                                                    \
+      ->Range(min_extent, max_extent);                                        \
+  BENCHMARK_TEMPLATE(to_layout, T, tt::TiledFaces, tt::RowMajor)              \
+      ->RangeMultiplier(4)                                                    \
+      ->Range(min_extent, max_extent);                                        \
+  BENCHMARK_TEMPLATE(to_layout, T, tt::RowMajor, tt::ColMajor)                \
+      ->RangeMultiplier(4)                                                    \
+      ->Range(min_extent, max_extent);                                        \
+  BENCHMARK_TEMPLATE(to_layout, T, tt::ColMajor, tt::RowMajor)                \
+      ->RangeMultiplier(4)                                                    \
+      ->Range(min_extent, max_extent);                                        \
+  BENCHMARK_TEMPLATE(to_layout_batched, T, tt::RowMajor, tt::Tiled)           \
+      ->Args({64, 64});                                                       \
+  BENCHMARK_TEMPLATE(to_layout_batched, T, tt::Tiled, tt::RowMajor)           \
+      ->Args({64, 64})
+
+TT_TO_LAYOUT_BENCHMARKS(tt::Float32);
+TT_TO_LAYOUT_BENCHMARKS(tt::BFloat16);
+TT_TO_LAYOUT_BENCHMARKS(tt::Float64);
+
+BENCHMARK(to_tiled_inplace)->RangeMultiplier(4)->Range(min_extent, max_extent);
+BENCHMARK(to_tiled_cached)->RangeMultiplier(4)->Range(min_extent, max_extent);
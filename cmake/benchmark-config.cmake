@@ -0,0 +1,17 @@
+include_guard(GLOBAL)
+
+include(FetchContent)
+
+set(BENCHMARK_ENABLE_TESTING
+    OFF
+    CACHE BOOL "Build the tests of google benchmark")
+set(BENCHMARK_ENABLE_INSTALL
+    OFF
+    CACHE BOOL "Install google benchmark")
+
+FetchContent_Declare(
+  benchmark
+  GIT_REPOSITORY https://github.com/google/benchmark.git
+  GIT_TAG v1.9.0
+  EXCLUDE_FROM_ALL)
+FetchContent_MakeAvailable(benchmark)
@@ -0,0 +1,288 @@
+// checks conversions in place, their refusal while a tensor is shared, and the
+// plans of captured graphs against the conversions they stand for, exiting
+// with the number of failed checks
+
+#include "any_graph.hpp"
+
+#include <tt/operators/arange.hpp>
+#include <tt/operators/reshape.hpp>
+#include <tt/operators/to_layout.hpp>
+#include <tt/operators/to_layout_inplace.hpp>
+#include <tt/runtime/memory_planner.hpp>
+
+#include <boost/mp11.hpp>
+#include <fmt/base.h>
+#include <fmt/ranges.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+auto check(bool condition, const std::string &message) -> void {
+  if (not condition) {
+    fmt::print("FAILED: {}\n", message);
+    ++failures;
+  }
+}
+
+// whether the tensors hold the same elements at the same indices, in any
+// layouts
+auto same_elements(const any_tensor &lhs, const any_tensor &rhs) -> bool {
+  if (lhs.dtype != rhs.dtype or lhs.extents != rhs.extents) {
+    return false;
+  }
+
+  const auto row_major = layout_index_v<tt::RowMajor>;
+  const auto lhs_dense = to_layout(lhs, row_major);
+  const auto rhs_dense = to_layout(rhs, row_major);
+  const auto element_size = visit_dtype(lhs.dtype, [](auto element) {
+    return sizeof(typename decltype(element)::type);
+  });
+
+  return std::memcmp(lhs_dense.data.get(), rhs_dense.data.get(),
+                     lhs.size() * element_size) == 0;
+}
+
+// row-major -> TLayout -> row-major within the buffer, through the operators
+// and through the bindings, for a matrix and a batch of matrices of whole
+// tiles
+template <class TLayout>
+auto check_inplace() -> void {
+  constexpr std::size_t height = TLayout::tile_height;
+  constexpr std::size_t width = TLayout::tile_width;
+
+  const auto name = fmt::format("{}x{}", height, width);
+  const std::vector<std::vector<std::size_t>> shapes{
+      {3 * height, 2 * width},
+      {2, 3, 2 * height, 3 * width},
+  };
+
+  for (const auto &shape : shapes) {
+    const auto size = size_of(shape);
+    const auto expected = with_extents(
+        from_tensor(tt::arange<tt::dtype::Int32>(std::int32_t(size))), shape);
+    const auto tiled = to_layout(expected, layout_index_v<TLayout>);
+
+    // a copy, which no other tensor shares as the bindings require
+    const auto input = to_layout(tiled, layout_index_v<tt::RowMajor>);
+    const auto converted = to_layout_inplace(input, layout_index_v<TLayout>);
+
+    check(converted.data == input.data,
+          fmt::format("{} ({}) converted out of place", name,
+                      fmt::join(shape, ", ")));
+    check(std::memcmp(converted.data.get(), tiled.data.get(),
+                      size * sizeof(std::int32_t)) == 0,
+          fmt::format("{} ({}) tiled in place differs from to_layout()", name,
+                      fmt::join(shape, ", ")));
+
+    const auto restored =
+        to_layout_inplace(converted, layout_index_v<tt::RowMajor>);
+
+    check(restored.strides == row_major_strides(shape) and
+              same_elements(restored, expected),
+          fmt::format("{} ({}) did not round-trip in place", name,
+                      fmt::join(shape, ", ")));
+  }
+
+  // the operators on a batch of matrices
+  const auto batch = tt::arange<tt::dtype::Int32>(
+                         std::int32_t(2 * 2 * height * 3 * width)) |
+                     tt::reshape(2, 2 * height, 3 * width);
+  const auto round_trip = tt::to_row_major_(tt::to_layout_<TLayout>(batch));
+  bool restored = true;
+
+  for (std::size_t index = 0; index < round_trip.size(); ++index) {
+    restored = restored and round_trip.data_handle()[index] ==
+                                static_cast<std::int32_t>(index);
+  }
+
+  check(restored, fmt::format("{} batch did not round-trip through "
+                              "tt::to_layout_",
+                              name));
+}
+
+// a call that reads a tensor on another thread holds a copy of it, taken as
+// the bindings take their arguments before releasing the gil, which refuses a
+// conversion in place of the tensor until the call returns
+auto check_inplace_shared() -> void {
+  const auto tensor = with_extents(
+      from_tensor(tt::arange<tt::dtype::Float32>(float(32 * 32))), {32, 32});
+  std::promise<void> release;
+  std::string formatted;
+
+  // the copy is captured before the thread starts, like an argument before
+  // the gil is released
+  std::thread reader{[&, copy = tensor] {
+    release.get_future().wait();
+    formatted = format(copy);
+  }};
+
+  const auto refused = [&] {
+    try {
+      check_unshared(tensor);
+    } catch (const std::invalid_argument &) {
+      return true;
+    }
+
+    return false;
+  };
+
+  check(refused(), "conversion in place of a tensor being read was allowed");
+
+  release.set_value();
+  reader.join();
+
+  check(not refused() and formatted == format(tensor),
+        "conversion in place refused once the reader returned");
+}
+
+// random lifetimes, of which those live at the same step must not overlap in
+// the arena
+auto check_plan_memory() -> void {
+  std::mt19937 random{2024};
+
+  for (std::size_t trial = 0; trial < 200; ++trial) {
+    std::vector<tt::buffer_lifetime> buffers(1 + random() % 16);
+
+    for (auto &buffer : buffers) {
+      buffer.size = 1 + random() % 4096;
+      buffer.alignment = std::size_t{1} << (random() % 12);
+      buffer.first = random() % 16;
+      buffer.last = buffer.first + random() % 8;
+    }
+
+    const auto plan = tt::plan_memory(buffers);
+
+    for (std::size_t index = 0; index < buffers.size(); ++index) {
+      const auto &buffer = buffers[index];
+      const auto offset = plan.offsets[index];
+
+      check(offset % buffer.alignment == 0 and
+                offset + buffer.size <= plan.size and
+                buffer.alignment <= plan.alignment,
+            fmt::format("trial {}: buffer {} misplaced", trial, index));
+
+      for (std::size_t other = 0; other < index; ++other) {
+        const auto live = buffers[other].first <= buffer.last and
+                          buffer.first <= buffers[other].last;
+        const auto overlap =
+            plan.offsets[other] < offset + buffer.size and
+            offset < plan.offsets[other] + buffers[other].size;
+
+        check(not(live and overlap),
+              fmt::format("trial {}: live buffers {} and {} overlap", trial,
+                          other, index));
+      }
+    }
+  }
+}
+
+// graphs replayed with their plans and arenas against their views applied one
+// at a time
+auto check_plan_views() -> void {
+  constexpr auto row_major = layout_index_v<tt::RowMajor>;
+  constexpr auto col_major = layout_index_v<tt::ColMajor>;
+  constexpr auto tiled = layout_index_v<tt::Tiled>;
+  constexpr auto tiled_8 = layout_index_v<tt::layout_right_tiled<8>>;
+  constexpr auto tiled_faces = layout_index_v<tt::TiledFaces>;
+
+  const auto to = [](std::size_t layout) -> any_view {
+    return any_to_layout_view{layout, std::nullopt};
+  };
+  const auto reshape = [](std::vector<std::size_t> extents) -> any_view {
+    return any_reshape_view{std::move(extents)};
+  };
+  const auto permute = [](std::vector<std::size_t> axes) -> any_view {
+    return any_permute_view{std::move(axes)};
+  };
+
+  const std::vector<std::vector<any_view>> graphs{
+      {to(tiled), to(row_major)},
+      {to(tiled), to(tiled_8), to(col_major), to(tiled_faces)},
+      {reshape({32, 64}), to(tiled), reshape({2, 16, 64}), to(row_major)},
+      {to(col_major), to(row_major), to(tiled)},
+      {permute({1, 0}), to(row_major), to(tiled), to(row_major)},
+      {tt::transpose_view{}, tt::transpose_view{}, to(tiled_8)},
+      {to(tiled), to(tiled_faces), to(tiled), to(tiled_8), to(row_major)},
+      {reshape({4, 8, 64}), permute({0, 2, 1}), to(tiled),
+       reshape({4, 64, 8})},
+  };
+
+  const auto input = with_extents(
+      from_tensor(tt::arange<tt::dtype::Float32>(float(64 * 32))), {64, 32});
+
+  for (const auto &views : graphs) {
+    const any_graph graph{views};
+    auto expected = input;
+
+    for (const auto &view : views) {
+      expected = std::visit([&](const auto &view) { return expected | view; },
+                            view);
+    }
+
+    // the rewritten views without the arena, then with it
+    auto planned = input;
+
+    for (const auto &view : graph.plan(input)->views) {
+      planned = std::visit([&](const auto &view) { return planned | view; },
+                           view);
+    }
+
+    check(same_elements(planned, expected),
+          fmt::format("{} planned differs", format_graph(views)));
+    check(same_elements(input | graph, expected),
+          fmt::format("{} replayed differs", format_graph(views)));
+  }
+
+  // inputs of more extents than a graph keeps plans for, the first of which
+  // is planned again once it is dropped, while a plan held meanwhile lives on
+  const any_graph graph{{any_to_layout_view{tiled, std::nullopt},
+                         any_to_layout_view{tiled_8, std::nullopt},
+                         any_to_layout_view{row_major, std::nullopt}}};
+  const auto held = graph.plan(input);
+
+  for (std::size_t rows = 1; rows <= 2 * max_graph_plans; ++rows) {
+    const auto matrix = with_extents(
+        from_tensor(tt::arange<tt::dtype::Float32>(float(rows * 8))),
+        {rows, 8});
+
+    check(same_elements(matrix | graph, matrix),
+          fmt::format("replay of {} rows differs", rows));
+  }
+
+  auto replayed = input;
+
+  for (const auto &view : held->views) {
+    replayed = std::visit([&](const auto &view) { return replayed | view; },
+                          view);
+  }
+
+  check(graph.plan(input) != held and same_elements(replayed, input),
+        "dropped plan was not planned again");
+}
+
+} // namespace
+
+int main() {
+  mp::mp_for_each<blocked_layout_types>(
+      [](auto layout) { check_inplace<decltype(layout)>(); });
+  check_inplace_shared();
+  check_plan_memory();
+  check_plan_views();
+
+  if (failures == 0) {
+    fmt::print("all checks passed\n");
+  }
+
+  return failures;
+}
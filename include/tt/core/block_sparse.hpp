@@ -0,0 +1,121 @@
+#pragma once
+
+#include <tt/core/concepts.hpp>
+#include <tt/core/layout.hpp>
+#include <tt/core/tile.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace tt {
+inline namespace core {
+
+// matrix in a tiled layout that stores only the tiles holding a non-zero
+// element, in the order of the dense layout; the stored tiles of each row of
+// tiles are listed by tile column, as in a CSR matrix whose entries are tiles
+template <class T, class TLayout>
+class block_sparse_matrix {
+  static_assert(tt::is_tiled_layout_v<TLayout>);
+
+public:
+  using element_type = T;
+  using layout_type = TLayout;
+  using extents_type = tt::dims<2>;
+  using index_type = std::size_t;
+  using tile_type = tt::tile<T, TLayout, 0>;
+
+private:
+  extents_type exts;
+  // first stored tile of each row of tiles, followed by the stored tile count
+  std::shared_ptr<index_type[]> row_offsets;
+  // tile column of each stored tile
+  std::shared_ptr<index_type[]> columns;
+  // tile_size elements of each stored tile
+  std::shared_ptr<T[]> data;
+
+public:
+  block_sparse_matrix(const extents_type &exts,
+                      std::shared_ptr<index_type[]> row_offsets,
+                      std::shared_ptr<index_type[]> columns,
+                      std::shared_ptr<T[]> data) noexcept
+      : exts(exts), row_offsets(std::move(row_offsets)),
+        columns(std::move(columns)), data(std::move(data)) {}
+
+  static constexpr auto rank() noexcept -> std::size_t { return 2; }
+
+  auto extents() const noexcept -> const extents_type & { return exts; }
+
+  auto extent(std::size_t r) const noexcept -> index_type {
+    return exts.extent(r);
+  }
+
+  auto tile_rows() const noexcept -> index_type {
+    return (exts.extent(0) + tile_type::height - 1) / tile_type::height;
+  }
+
+  auto tile_cols() const noexcept -> index_type {
+    return (exts.extent(1) + tile_type::width - 1) / tile_type::width;
+  }
+
+  auto stored_tiles() const noexcept -> index_type {
+    return row_offsets[this->tile_rows()];
+  }
+
+  // fraction of the tiles that are stored
+  auto density() const noexcept -> double {
+    const auto tiles = this->tile_rows() * this->tile_cols();
+
+    return tiles == 0 ? 0.0
+                      : static_cast<double>(this->stored_tiles()) /
+                            static_cast<double>(tiles);
+  }
+
+  // stored tile at index, in storage order
+  auto tile(index_type tile_row, index_type index) const noexcept
+      -> tile_type {
+    assert(index < this->stored_tiles());
+
+    const auto row = tile_row * tile_type::height;
+    const auto col = columns[index] * tile_type::width;
+
+    return {
+        data.get() + index * tile_type::size(),
+        {},
+        row,
+        col,
+        std::min(tile_type::height, exts.extent(0) - row),
+        std::min(tile_type::width, exts.extent(1) - col),
+    };
+  }
+
+  // visits the stored tiles of one row of tiles in order of their columns
+  template <class TCallback>
+  auto for_each_tile(index_type tile_row, TCallback callback) const -> void {
+    for (auto index = row_offsets[tile_row]; index < row_offsets[tile_row + 1];
+         ++index) {
+      callback(this->tile(tile_row, index));
+    }
+  }
+
+  template <class TCallback>
+  auto for_each_tile(TCallback callback) const -> void {
+    for (index_type tile_row = 0; tile_row < this->tile_rows(); ++tile_row) {
+      this->for_each_tile(tile_row, callback);
+    }
+  }
+};
+
+template <class T>
+inline constexpr bool is_block_sparse_v = false;
+
+template <class T, class TLayout>
+inline constexpr bool is_block_sparse_v<tt::block_sparse_matrix<T, TLayout>> =
+    true;
+
+template <class T>
+inline constexpr bool block_sparse = tt::is_block_sparse_v<T>;
+
+} // namespace core
+} // namespace tt
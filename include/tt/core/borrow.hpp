@@ -0,0 +1,92 @@
+#pragma once
+
+#include <tt/core/concepts.hpp>
+#include <tt/core/generator_accessor.hpp>
+#include <tt/core/inline_accessor.hpp>
+#include <tt/core/tensor.hpp>
+#include <tt/core/weak_accessor.hpp>
+
+#include <memory>
+#include <type_traits>
+
+namespace tt {
+inline namespace core {
+namespace detail {
+namespace {
+
+template <class T>
+constexpr auto borrow_data_handle(T *data_handle) noexcept -> T * {
+  return data_handle;
+}
+
+template <class T>
+constexpr auto
+borrow_data_handle(const std::shared_ptr<T[]> &data_handle) noexcept -> T * {
+  return data_handle.get();
+}
+
+template <class T, std::size_t Size>
+constexpr auto
+borrow_data_handle(const tt::inline_buffer<T, Size> &data_handle) noexcept
+    -> const T * {
+  return data_handle.values.data();
+}
+
+} // namespace
+} // namespace detail
+
+// Returns a non-owning view of the input that indexes through a raw pointer.
+// The view must not outlive the buffer it was borrowed from, which for a
+// fixed-size tensor is the tensor itself; that of a fixed-size tensor only
+// reads its elements. Generated tensors hold no buffer and
+// are returned as they are. Weak tensors are refused, since nothing would keep
+// their buffer alive while the view is used; borrow from tt::lock() instead,
+// and hold the locked tensor as long as the view.
+struct borrow_fn {
+  template <class TInput, class = std::enable_if_t<tt::tensor<TInput>>>
+  constexpr auto operator()(const TInput &input) const noexcept {
+    static_assert(not tt::weak<TInput>,
+                  "tt::borrow() of a weak tensor: borrow tt::lock(input)");
+
+    // the elements of a fixed-size tensor are read-only
+    using element_type =
+        std::conditional_t<tt::fixed_size<TInput>,
+                           const tt::element_type_t<TInput>,
+                           tt::element_type_t<TInput>>;
+    using extents_type = tt::extents_type_t<TInput>;
+    using layout_type = tt::layout_type_t<TInput>;
+    using output_type =
+        tt::BorrowedTensor<element_type, extents_type, layout_type>;
+
+    if constexpr (std::is_same_v<TInput, output_type> or
+                  tt::generated<TInput>) {
+      return input;
+    } else {
+      return output_type{detail::borrow_data_handle(input.data_handle()),
+                         input.mapping()};
+    }
+  }
+};
+
+inline constexpr tt::borrow_fn borrow{};
+
+// tensor that shares the buffer of a weak tensor and keeps it alive, with a
+// null buffer if it has already been freed
+template <class TInput, class = std::enable_if_t<tt::weak<TInput>>>
+auto lock(const TInput &input) noexcept {
+  using element_type = tt::element_type_t<TInput>;
+  using extents_type = tt::extents_type_t<TInput>;
+  using layout_type = tt::layout_type_t<TInput>;
+
+  return tt::Tensor<element_type, extents_type, layout_type>{
+      input.data_handle().lock(), input.mapping()};
+}
+
+// tensor whose elements can be written through a copy of it, as operators do
+// with the tensors passed as their out parameter
+template <class T>
+inline constexpr bool writable =
+    tt::tensor<T> and not tt::generated<T> and not tt::fixed_size<T>;
+
+} // namespace core
+} // namespace tt
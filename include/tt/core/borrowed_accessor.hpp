@@ -0,0 +1,47 @@
+#pragma once
+
+#include <tt/core/offset_policy.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace tt {
+inline namespace core {
+
+template <class T, class = std::enable_if_t<tt::arithmetic<T>>>
+struct borrowed_accessor {
+  using offset_policy = borrowed_accessor;
+  using element_type = T;
+  using reference = T &;
+  using data_handle_type = T *;
+
+  constexpr borrowed_accessor() noexcept = default;
+
+  template <class TOtherElement, class TOffsetPolicy,
+            class = std::enable_if_t<std::is_convertible_v<
+                TOtherElement (*)[], element_type (*)[]>>>
+  constexpr borrowed_accessor(
+      const shared_accessor<TOtherElement, TOffsetPolicy> &) noexcept {}
+
+  template <class TOtherElement, class = std::enable_if_t<std::is_convertible_v<
+                                     TOtherElement (*)[], element_type (*)[]>>>
+  constexpr borrowed_accessor(const weak_accessor<TOtherElement> &) noexcept {}
+
+  template <class TOtherElement, class = std::enable_if_t<std::is_convertible_v<
+                                     TOtherElement (*)[], element_type (*)[]>>>
+  constexpr borrowed_accessor(
+      const borrowed_accessor<TOtherElement> &) noexcept {}
+
+  static constexpr auto access(data_handle_type data_handle,
+                               std::size_t index) noexcept -> reference {
+    return data_handle[index];
+  }
+
+  static constexpr auto offset(data_handle_type data_handle,
+                               std::size_t index) noexcept -> data_handle_type {
+    return data_handle + index;
+  }
+};
+
+} // namespace core
+} // namespace tt
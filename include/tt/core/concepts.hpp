@@ -49,5 +49,14 @@ inline constexpr bool matrix = tt::tensor<T> and tt::has_rank<T, 2>;
 template <class T>
 inline constexpr bool vector = tt::tensor<T> and tt::has_rank<T, 1>;
 
+template <class T, class = void>
+inline constexpr bool tiled = false;
+
+template <class T>
+inline constexpr bool
+    tiled<T, std::enable_if_t<tt::tensor<T> and
+                              tt::is_tiled_layout_v<tt::layout_type_t<T>>>> =
+        true;
+
 } // namespace core
 } // namespace tt
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <tt/core/memory_stats.hpp>
+
+#include <cstdlib>
 #include <memory>
 
 namespace tt {
@@ -10,15 +13,40 @@ template <class T>
 class allocator_delete {
   std::allocator<T> alloc;
   std::size_t elements;
+  detail::allocation buffer;
 
 public:
   constexpr allocator_delete(const allocator_delete &other) noexcept = default;
 
-  constexpr allocator_delete(const std::allocator<T> &alloc,
-                             const std::size_t elements) noexcept
-      : alloc(alloc), elements(elements) {}
+  // charges the buffer to the memory stats until it is deleted
+  allocator_delete(const std::allocator<T> &alloc, const std::size_t elements,
+                   const detail::allocation &buffer) noexcept
+      : alloc(alloc), elements(elements), buffer(buffer) {
+    detail::charge(buffer);
+  }
+
+  auto operator()(T *ptr) -> void {
+    alloc.deallocate(ptr, elements);
+    detail::discharge(buffer);
+  }
+};
+
+// frees a buffer from std::calloc
+class free_delete {
+  detail::allocation buffer;
+
+public:
+  constexpr free_delete(const free_delete &other) noexcept = default;
+
+  explicit free_delete(const detail::allocation &buffer) noexcept
+      : buffer(buffer) {
+    detail::charge(buffer);
+  }
 
-  constexpr auto operator()(T *ptr) -> void { alloc.deallocate(ptr, elements); }
+  auto operator()(void *ptr) -> void {
+    std::free(ptr);
+    detail::discharge(buffer);
+  }
 };
 
 } // namespace detail
@@ -3,6 +3,8 @@
 #include <tt/core/float.hpp>
 #include <tt/core/int.hpp>
 
+#include <type_traits>
+
 namespace tt {
 inline namespace core {
 
@@ -37,5 +39,14 @@ struct dtypes : dtype_traits<tt::Float32, tt::dtype::Float32>,
   using fn = dtype_traits<T, V>;
 };
 
+// whether T is the element type of a dtype, unlike e.g. tt::Complex64
+template <class T, class = void>
+inline constexpr bool has_dtype_v = false;
+
+template <class T>
+inline constexpr bool has_dtype_v<
+    T, std::void_t<decltype(detail::as_value<T, tt::dtypes::fn>(
+           tt::dtypes{}))>> = true;
+
 } // namespace core
 } // namespace tt
@@ -194,7 +194,7 @@ struct std::numeric_limits<tt::BFloat16> {
 
   static constexpr auto quiet_NaN() noexcept -> tt::BFloat16 {
     constexpr auto quiet_NaN_value =
-        tt::bit_cast<tt::BFloat16>(tt::detail::BFloat16_quiet_NaN);
+        tt::bit_cast<tt::BFloat16>(tt::core::detail::BFloat16_quiet_NaN);
     return quiet_NaN_value;
   }
 
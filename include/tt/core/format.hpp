@@ -1,5 +1,6 @@
 #pragma once
 
+#include <tt/core/borrow.hpp>
 #include <tt/core/concepts.hpp>
 
 #include <fmt/base.h>
@@ -21,9 +22,11 @@ public:
 
   constexpr auto format(const TInput &input, fmt::format_context &ctx) const
       -> fmt::format_context::iterator {
+    const auto input_view = tt::borrow(input);
+
     if constexpr (TInput::rank() == 0) {
       auto out = fmt::format_to(ctx.out(), "tensor(");
-      out = element_formatter.format(+input(), ctx);
+      out = element_formatter.format(+input_view(), ctx);
       return fmt::format_to(out, ")");
     } else {
       constexpr std::string_view prefix = "tensor([";
@@ -38,7 +41,7 @@ public:
               out = fmt::format_to(out, ", ");
             }
 
-            out = element_formatter.format(+input(indices..., index), ctx);
+            out = element_formatter.format(+input_view(indices..., index), ctx);
           } else {
             if (index > 0) {
               constexpr auto indentation = prefix.size() + rank;
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <tt/core/concepts.hpp>
+#include <tt/core/layout.hpp>
+
+#include <cstddef>
+
+namespace tt {
+inline namespace core {
+
+// start + index * step, computed in TCompute like the elements of tt::arange
+template <class T, class TCompute = T>
+struct affine_generator {
+  using value_type = T;
+
+  TCompute start;
+  TCompute step;
+
+  constexpr auto operator()(std::size_t index) const noexcept -> T {
+    return start + index * step;
+  }
+};
+
+// one on every period-th element, for the first count of them, and zero
+// elsewhere; a period of cols + 1 is the diagonal of a row-major matrix
+template <class T>
+struct diagonal_generator {
+  using value_type = T;
+
+  std::size_t period;
+  std::size_t count;
+
+  constexpr auto operator()(std::size_t index) const noexcept -> T {
+    return index % period == 0 and index / period < count ? T{1} : T{0};
+  }
+};
+
+template <class T>
+struct constant_generator {
+  using value_type = T;
+
+  T value;
+
+  constexpr auto operator()(std::size_t) const noexcept -> T { return value; }
+};
+
+// generator and the offset of the first element of a view into its elements
+template <class TGenerator>
+struct generator_handle {
+  TGenerator generator;
+  std::size_t offset = 0;
+};
+
+// computes each element from its offset when read, so that a tensor of
+// generated elements holds no buffer; elements are read-only values
+template <class TGenerator>
+struct generator_accessor {
+  using offset_policy = generator_accessor;
+  using element_type = typename TGenerator::value_type;
+  using reference = element_type;
+  using data_handle_type = tt::generator_handle<TGenerator>;
+
+  static constexpr auto access(const data_handle_type &data_handle,
+                               std::size_t index) noexcept -> reference {
+    return data_handle.generator(data_handle.offset + index);
+  }
+
+  static constexpr auto offset(const data_handle_type &data_handle,
+                               std::size_t index) noexcept
+      -> data_handle_type {
+    return {data_handle.generator, data_handle.offset + index};
+  }
+};
+
+template <class TGenerator, class TExtents, class TLayout = tt::RowMajor,
+          class = std::enable_if_t<tt::extents<TExtents>>>
+using GeneratedTensor =
+    std::mdspan<typename TGenerator::value_type, TExtents, TLayout,
+                tt::generator_accessor<TGenerator>>;
+
+template <class T>
+inline constexpr bool is_generated_v = false;
+
+template <class TElement, class TExtents, class TLayout, class TGenerator>
+inline constexpr bool is_generated_v<std::mdspan<
+    TElement, TExtents, TLayout, tt::generator_accessor<TGenerator>>> = true;
+
+// tensor whose elements have no address, such as tt::lazy::arange()
+template <class T>
+inline constexpr bool generated = tt::is_generated_v<T>;
+
+} // namespace core
+} // namespace tt
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <tt/core/borrowed_accessor.hpp>
+#include <tt/core/concepts.hpp>
+#include <tt/core/layout.hpp>
+
+#include <array>
+#include <cstddef>
+
+namespace tt {
+inline namespace core {
+
+// Size elements held by value, so that a tensor is stored wherever it is
+// declared, e.g. on the stack, and copying the tensor copies its elements
+template <class T, std::size_t Size>
+struct inline_buffer {
+  std::array<T, Size> values{};
+};
+
+// elements of a tensor whose extents are all static, stored in its data handle
+// instead of behind a pointer; views into it borrow the buffer. mdspan only
+// reads its data handle through const, so the elements are read-only, and the
+// operators that produce such tensors write their buffer before wrapping it
+template <class T, std::size_t Size,
+          class = std::enable_if_t<tt::arithmetic<T>>>
+struct inline_accessor {
+  using offset_policy = tt::borrowed_accessor<const T>;
+  using element_type = T;
+  using reference = const T &;
+  using data_handle_type = tt::inline_buffer<T, Size>;
+
+  static constexpr auto access(const data_handle_type &data_handle,
+                               std::size_t index) noexcept -> reference {
+    return data_handle.values[index];
+  }
+
+  static constexpr auto
+  offset(const data_handle_type &data_handle,
+         std::size_t index) noexcept -> const T * {
+    return data_handle.values.data() + index;
+  }
+};
+
+template <class TExtents, class = void>
+inline constexpr bool is_static_extents_v = false;
+
+template <class TExtents>
+inline constexpr bool is_static_extents_v<
+    TExtents, std::enable_if_t<tt::extents<TExtents> and
+                               TExtents::rank_dynamic() == 0>> = true;
+
+// elements spanned by the mapping of static extents, padding included
+template <class TExtents, class TLayout>
+inline constexpr std::size_t static_span_size_v =
+    typename TLayout::template mapping<TExtents>{}.required_span_size();
+
+template <class T, class TExtents, class TLayout = tt::RowMajor,
+          class = std::enable_if_t<tt::arithmetic<T> and
+                                   tt::is_static_extents_v<TExtents>>>
+using InlineTensor =
+    std::mdspan<T, TExtents, TLayout,
+                tt::inline_accessor<T, static_span_size_v<TExtents, TLayout>>>;
+
+template <class T>
+inline constexpr bool is_inline_v = false;
+
+template <class TElement, class TExtents, class TLayout, std::size_t Size>
+inline constexpr bool is_inline_v<std::mdspan<
+    TElement, TExtents, TLayout, tt::inline_accessor<TElement, Size>>> = true;
+
+// tensor that holds its elements by value, such as tt::fixed::zeros()
+template <class T>
+inline constexpr bool fixed_size = tt::is_inline_v<T>;
+
+} // namespace core
+} // namespace tt
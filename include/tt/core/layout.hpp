@@ -20,20 +20,24 @@ constexpr auto find_next_multiple(std::size_t alignment,
 }
 
 } // namespace
-} // namespace detail
 
-inline constexpr std::size_t default_tile_extent = 4;
+// storage order shared by tiled layouts: tiles are stored contiguously in
+// row-major order of the tile grid, one grid per matrix spanned by the two
+// innermost extents, and each layout orders the elements within a tile
+template <class TLayout, class TExtents>
+struct tiled_mapping {
+  using extents_type = TExtents;
+  using index_type = tt::index_type_t<extents_type>;
+  using size_type = tt::size_type_t<extents_type>;
+  using rank_type = tt::rank_type_t<extents_type>;
+  using layout_type = TLayout;
 
-template <std::size_t TileHeight = tt::default_tile_extent,
-          std::size_t TileWidth = TileHeight>
-struct layout_right_tiled {
 private:
-  static constexpr std::size_t tile_height = TileHeight;
-  static constexpr std::size_t tile_width = TileWidth;
-  static constexpr std::size_t tile_size = tile_height * tile_width;
+  static constexpr std::size_t tile_height = TLayout::tile_height;
+  static constexpr std::size_t tile_width = TLayout::tile_width;
+  static constexpr std::size_t tile_size = TLayout::tile_size;
 
-  template <class TExtents>
-  using padding = std::extents<
+  using padding_type = std::extents<
       std::size_t,
       detail::find_next_multiple(
           tile_height, TExtents::rank() >= 2
@@ -44,173 +48,243 @@ private:
                           ? TExtents::static_extent(TExtents::rank() - 1)
                           : tile_width)>;
 
-  static_assert(tile_height != std::dynamic_extent and
-                tile_width != std::dynamic_extent);
-  static_assert(tt::has_single_bit(tile_size));
+  static constexpr auto
+  make_padding(const extents_type &exts) noexcept -> padding_type {
+    return padding_type{
+        detail::find_next_multiple(tile_height,
+                                   TExtents::rank() >= 2
+                                       ? exts.extent(TExtents::rank() - 2)
+                                       : tile_height),
+        detail::find_next_multiple(tile_width,
+                                   TExtents::rank() >= 1
+                                       ? exts.extent(TExtents::rank() - 1)
+                                       : tile_width),
+    };
+  }
 
-public:
-  template <class TExtents, class = std::enable_if_t<tt::extents<TExtents>>>
-  struct mapping {
-    using extents_type = TExtents;
-    using index_type = tt::index_type_t<extents_type>;
-    using size_type = tt::size_type_t<extents_type>;
-    using rank_type = tt::rank_type_t<extents_type>;
-    using layout_type = layout_right_tiled;
-
-  private:
-    using padding_type = layout_right_tiled::padding<TExtents>;
-
-    static constexpr auto
-    make_padding(const extents_type &exts) noexcept -> padding_type {
-      return padding_type{
-          detail::find_next_multiple(tile_height,
-                                     TExtents::rank() >= 2
-                                         ? exts.extent(TExtents::rank() - 2)
-                                         : tile_height),
-          detail::find_next_multiple(tile_width,
-                                     TExtents::rank() >= 1
-                                         ? exts.extent(TExtents::rank() - 1)
-                                         : tile_width),
-      };
-    }
+  [[no_unique_address]] extents_type exts;
+  [[no_unique_address]] padding_type pads;
 
-    [[no_unique_address]] extents_type exts;
-    [[no_unique_address]] padding_type pads;
+  constexpr auto
+  accumulate_offset(index_type value, index_type row,
+                    index_type col) const noexcept -> index_type {
+    return this->pads.extent(1) *
+               (value + (row / tile_height) * tile_height) +
+           (col / tile_width) * tile_size +
+           TLayout::offset_in_tile(row % tile_height, col % tile_width);
+  }
 
-    constexpr auto
-    accumulate_offset(index_type value, index_type row,
-                      index_type col) const noexcept -> index_type {
-      return this->pads.extent(1) *
-                 (value + (row / tile_height) * tile_height) +
-             (row % tile_height) * tile_width + (col / tile_width) * tile_size +
-             (col % tile_width);
-    }
+  constexpr auto
+  accumulate_offset(index_type value) const noexcept -> index_type {
+    return accumulate_offset(value, 0, 0);
+  }
 
-    constexpr auto
-    accumulate_offset(index_type value) const noexcept -> index_type {
-      return accumulate_offset(value, 0, 0);
-    }
+  constexpr auto
+  accumulate_offset(index_type value,
+                    index_type col) const noexcept -> index_type {
+    return accumulate_offset(value, 0, col);
+  }
 
-    constexpr auto
-    accumulate_offset(index_type value,
-                      index_type col) const noexcept -> index_type {
-      return accumulate_offset(value, 0, col);
+  template <class... TIndices>
+  constexpr auto
+  accumulate_offset(index_type value, index_type index,
+                    TIndices... indices) const noexcept -> index_type {
+    if constexpr (sizeof...(indices) == 2) {
+      return this->accumulate_offset(this->pads.extent(0) * (value + index),
+                                     indices...);
+    } else {
+      constexpr rank_type r = extents_type::rank() - sizeof...(indices);
+
+      return this->accumulate_offset(this->exts.extent(r) * (value + index),
+                                     indices...);
     }
+  }
 
-    template <class... TIndices>
-    constexpr auto
-    accumulate_offset(index_type value, index_type index,
-                      TIndices... indices) const noexcept -> index_type {
-      if constexpr (sizeof...(indices) == 2) {
-        return this->accumulate_offset(this->pads.extent(0) * (value + index),
-                                       indices...);
-      } else {
-        constexpr rank_type r = extents_type::rank() - sizeof...(indices);
-
-        return this->accumulate_offset(this->exts.extent(r) * (value + index),
-                                       indices...);
-      }
-    }
+public:
+  constexpr tiled_mapping() noexcept : tiled_mapping(extents_type{}) {}
 
-  public:
-    constexpr mapping() noexcept : mapping(extents_type{}) {}
+  constexpr tiled_mapping(const tiled_mapping &) noexcept = default;
 
-    constexpr mapping(const mapping &) noexcept = default;
+  constexpr auto
+  operator=(const tiled_mapping &) noexcept -> tiled_mapping & = default;
 
-    constexpr auto operator=(const mapping &) noexcept -> mapping & = default;
+  constexpr tiled_mapping(const extents_type &exts) noexcept
+      : exts(exts), pads(tiled_mapping::make_padding(exts)) {}
 
-    constexpr mapping(const extents_type &exts) noexcept
-        : exts(exts), pads(mapping::make_padding(exts)) {}
+  template <class TMapping>
+  constexpr auto operator==(const TMapping &rhs) const noexcept
+      -> std::enable_if_t<tt::mapping<TMapping, layout_type> and
+                              TMapping::extents_type::rank() ==
+                                  extents_type::rank(),
+                          bool> {
+    return this->exts == rhs.extents();
+  }
 
-    template <class TMapping>
-    constexpr auto operator==(const TMapping &rhs) const noexcept
-        -> std::enable_if_t<tt::mapping<TMapping, layout_type> and
-                                TMapping::extents_type::rank() ==
-                                    extents_type::rank(),
-                            bool> {
-      return this->exts == rhs.extents();
-    }
+  constexpr auto extents() const noexcept -> const extents_type & {
+    return exts;
+  }
 
-    constexpr auto extents() const noexcept -> const extents_type & {
-      return exts;
-    }
+  constexpr auto tile_rows() const noexcept -> index_type {
+    return this->pads.extent(0) / tile_height;
+  }
 
-    template <class... TIndices>
-    constexpr auto operator()(TIndices... indices) const noexcept
-        -> std::enable_if_t<(... and tt::index<TIndices>), index_type> {
-      return this->accumulate_offset(0, static_cast<index_type>(indices)...);
-    }
+  constexpr auto tile_cols() const noexcept -> index_type {
+    return this->pads.extent(1) / tile_width;
+  }
 
-    constexpr auto required_span_size() const noexcept -> index_type {
-      if constexpr (extents_type::rank() < 2) {
-        return this->pads.extent(0) * this->pads.extent(1);
-      } else {
-        return this->exts.extent(0) * this->stride(0);
-      }
+  constexpr auto tile_count() const noexcept -> index_type {
+    index_type value = this->tile_rows() * this->tile_cols();
+
+    for (rank_type r = 0; r + 2 < extents_type::rank(); ++r) {
+      value *= this->exts.extent(r);
     }
 
-    constexpr auto stride(rank_type r) const noexcept -> index_type {
-      constexpr rank_type unpadded_ranks =
-          extents_type::rank() >= 2 ? extents_type::rank() - 2 : 0;
+    return value;
+  }
+
+  template <class... TIndices>
+  constexpr auto operator()(TIndices... indices) const noexcept
+      -> std::enable_if_t<(... and tt::index<TIndices>), index_type> {
+    return this->accumulate_offset(0, static_cast<index_type>(indices)...);
+  }
+
+  constexpr auto required_span_size() const noexcept -> index_type {
+    return this->tile_count() * tile_size;
+  }
 
-      assert(r < unpadded_ranks);
+  constexpr auto stride(rank_type r) const noexcept -> index_type {
+    constexpr rank_type unpadded_ranks =
+        extents_type::rank() >= 2 ? extents_type::rank() - 2 : 0;
 
-      index_type value = this->pads.extent(0) * this->pads.extent(1);
+    assert(r < unpadded_ranks);
 
-      for (rank_type i = r + 1; i < unpadded_ranks; ++i) {
-        value *= this->exts.extent(i);
-      }
+    index_type value = this->pads.extent(0) * this->pads.extent(1);
 
-      return value;
+    for (rank_type i = r + 1; i < unpadded_ranks; ++i) {
+      value *= this->exts.extent(i);
     }
 
-    static constexpr auto is_always_unique() noexcept -> bool { return true; }
-
-    static constexpr auto is_always_strided() noexcept -> bool { return false; }
-
-    static constexpr auto is_always_exhaustive() noexcept -> bool {
-      constexpr rank_type rank = extents_type::rank();
-
-      if constexpr (rank < 2) {
-        return false;
-      } else if constexpr (extents_type::static_extent(rank - 2) ==
-                               std::dynamic_extent or
-                           extents_type::static_extent(rank - 1) ==
-                               std::dynamic_extent) {
-        return false;
-      } else {
-        return extents_type::static_extent(rank - 2) ==
-                   padding_type::static_extent(0) and
-               extents_type::static_extent(rank - 1) ==
-                   padding_type::static_extent(1);
-      }
+    return value;
+  }
+
+  static constexpr auto is_always_unique() noexcept -> bool { return true; }
+
+  static constexpr auto is_always_strided() noexcept -> bool { return false; }
+
+  static constexpr auto is_always_exhaustive() noexcept -> bool {
+    constexpr rank_type rank = extents_type::rank();
+
+    if constexpr (rank < 2) {
+      return false;
+    } else if constexpr (extents_type::static_extent(rank - 2) ==
+                             std::dynamic_extent or
+                         extents_type::static_extent(rank - 1) ==
+                             std::dynamic_extent) {
+      return false;
+    } else {
+      return extents_type::static_extent(rank - 2) ==
+                 padding_type::static_extent(0) and
+             extents_type::static_extent(rank - 1) ==
+                 padding_type::static_extent(1);
     }
+  }
 
-    static constexpr auto is_unique() noexcept -> bool { return true; }
+  static constexpr auto is_unique() noexcept -> bool { return true; }
 
-    constexpr auto is_exhaustive() const noexcept -> bool {
-      constexpr rank_type rank = extents_type::rank();
+  constexpr auto is_exhaustive() const noexcept -> bool {
+    constexpr rank_type rank = extents_type::rank();
 
-      if constexpr (rank < 2) {
-        return false;
-      } else {
-        return this->exts.extent(rank - 2) == this->pads.extent(0) and
-               this->exts.extent(rank - 1) == this->pads.extent(1);
-      }
+    if constexpr (rank < 2) {
+      return false;
+    } else {
+      return this->exts.extent(rank - 2) == this->pads.extent(0) and
+             this->exts.extent(rank - 1) == this->pads.extent(1);
     }
+  }
+
+  static constexpr auto is_strided() noexcept -> bool { return false; }
+};
+
+} // namespace detail
+
+inline constexpr std::size_t default_tile_extent = 4;
+inline constexpr std::size_t default_face_extent = 16;
 
-    static constexpr auto is_strided() noexcept -> bool { return false; }
-  };
+template <std::size_t TileHeight = tt::default_tile_extent,
+          std::size_t TileWidth = TileHeight>
+struct layout_right_tiled {
+  static constexpr std::size_t tile_height = TileHeight;
+  static constexpr std::size_t tile_width = TileWidth;
+  static constexpr std::size_t tile_size = tile_height * tile_width;
+  // a tile is a single face
+  static constexpr std::size_t face_height = tile_height;
+  static constexpr std::size_t face_width = tile_width;
+  // elements of a tile row that are stored contiguously
+  static constexpr std::size_t contiguous_width = tile_width;
+
+  static_assert(tile_height != std::dynamic_extent and
+                tile_width != std::dynamic_extent);
+  static_assert(tt::has_single_bit(tile_size));
+
+  // offset of an element relative to the first element of its tile
+  static constexpr auto offset_in_tile(std::size_t row,
+                                       std::size_t col) noexcept
+      -> std::size_t {
+    return row * tile_width + col;
+  }
+
+  template <class TExtents, class = std::enable_if_t<tt::extents<TExtents>>>
+  using mapping = detail::tiled_mapping<layout_right_tiled, TExtents>;
+};
+
+// tiles stored as a row-major grid of faces, each face stored row-major, so
+// that a face can stay resident in L1 while the tiles around it stream
+template <std::size_t TileHeight = 2 * tt::default_face_extent,
+          std::size_t TileWidth = TileHeight,
+          std::size_t FaceHeight = TileHeight / 2,
+          std::size_t FaceWidth = TileWidth / 2>
+struct layout_right_tiled_faces {
+  static constexpr std::size_t tile_height = TileHeight;
+  static constexpr std::size_t tile_width = TileWidth;
+  static constexpr std::size_t tile_size = tile_height * tile_width;
+  static constexpr std::size_t face_height = FaceHeight;
+  static constexpr std::size_t face_width = FaceWidth;
+  static constexpr std::size_t face_size = face_height * face_width;
+  static constexpr std::size_t contiguous_width = face_width;
+
+  static_assert(tile_height != std::dynamic_extent and
+                tile_width != std::dynamic_extent);
+  static_assert(tt::has_single_bit(tile_size) and
+                tt::has_single_bit(face_size));
+  static_assert(tile_height % face_height == 0 and
+                tile_width % face_width == 0);
+
+  static constexpr auto offset_in_tile(std::size_t row,
+                                       std::size_t col) noexcept
+      -> std::size_t {
+    constexpr auto faces_per_row = tile_width / face_width;
+
+    return ((row / face_height) * faces_per_row + col / face_width) *
+               face_size +
+           (row % face_height) * face_width + col % face_width;
+  }
+
+  template <class TExtents, class = std::enable_if_t<tt::extents<TExtents>>>
+  using mapping = detail::tiled_mapping<layout_right_tiled_faces, TExtents>;
 };
 
 using RowMajor = std::layout_right;
+using ColMajor = std::layout_left;
 using Strided = std::layout_stride;
 using Tiled = tt::layout_right_tiled<>;
+using TiledFaces = tt::layout_right_tiled_faces<>;
 
 enum class layout {
   RowMajor,
+  ColMajor,
   Strided,
   Tiled,
+  TiledFaces,
 };
 
 template <class T, tt::layout V>
@@ -220,8 +294,10 @@ struct layout_traits {
 };
 
 struct layouts : layout_traits<tt::RowMajor, tt::layout::RowMajor>,
+                 layout_traits<tt::ColMajor, tt::layout::ColMajor>,
                  layout_traits<tt::Strided, tt::layout::Strided>,
-                 layout_traits<tt::Tiled, tt::layout::Tiled> {
+                 layout_traits<tt::Tiled, tt::layout::Tiled>,
+                 layout_traits<tt::TiledFaces, tt::layout::TiledFaces> {
   template <class T, tt::layout V>
   using fn = layout_traits<T, V>;
 };
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <tt/core/dtype.hpp>
+#include <tt/core/layout.hpp>
+#include <tt/core/tensor.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <system_error>
+
+#if defined(__unix__) or defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tt {
+inline namespace core {
+namespace detail {
+
+#if defined(__unix__) or defined(__APPLE__)
+
+// unmaps a file mapped by detail::map_file
+class unmap_delete {
+  std::size_t bytes;
+
+public:
+  explicit unmap_delete(std::size_t bytes) noexcept : bytes(bytes) {}
+
+  auto operator()(void *pointer) const noexcept -> void {
+    if (pointer != nullptr) {
+      ::munmap(pointer, this->bytes);
+    }
+  }
+};
+
+// maps bytes of the file at path, which is created or resized to hold them
+// and mapped shared if create is set, and otherwise must hold them and is
+// mapped private, so that writes to the mapping stay in memory
+inline auto map_file(const std::string &path, std::size_t bytes, bool create)
+    -> std::shared_ptr<std::byte[]> {
+  const auto file = create ? ::open(path.c_str(), O_RDWR | O_CREAT, 0644)
+                           : ::open(path.c_str(), O_RDONLY);
+
+  const auto fail = [&](int error) {
+    if (file >= 0) {
+      ::close(file);
+    }
+
+    throw std::system_error{error, std::generic_category(), path};
+  };
+
+  if (file < 0) {
+    fail(errno);
+  }
+
+  if (create) {
+    if (::ftruncate(file, static_cast<off_t>(bytes)) != 0) {
+      fail(errno);
+    }
+  } else {
+    struct stat status {};
+
+    if (::fstat(file, &status) != 0) {
+      fail(errno);
+    }
+
+    if (static_cast<std::uintmax_t>(status.st_size) < bytes) {
+      fail(EINVAL);
+    }
+  }
+
+  const auto pointer =
+      bytes > 0 ? ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                         create ? MAP_SHARED : MAP_PRIVATE, file, 0)
+                : nullptr;
+
+  if (pointer == MAP_FAILED) {
+    fail(errno);
+  }
+
+  // the mapping keeps the file open on its own
+  ::close(file);
+
+  return {static_cast<std::byte *>(pointer), detail::unmap_delete{bytes}};
+}
+
+#endif
+
+template <class TElement, class TLayout, class TExtents>
+auto map_tensor(const std::string &path, const TExtents &extents, bool create)
+    -> tt::Tensor<TElement, TExtents, TLayout> {
+  const typename TLayout::template mapping<TExtents> mapping{extents};
+
+#if defined(__unix__) or defined(__APPLE__)
+  const auto bytes = detail::map_file(
+      path, mapping.required_span_size() * sizeof(TElement), create);
+
+  return {std::shared_ptr<TElement[]>{
+              bytes, reinterpret_cast<TElement *>(bytes.get())},
+          mapping};
+#else
+  throw std::system_error{std::make_error_code(std::errc::not_supported),
+                          path};
+#endif
+}
+
+} // namespace detail
+
+// tensor of the dtype and layout whose elements are the bytes of the file at
+// path, which the kernel reads as they are touched and may drop again under
+// memory pressure, so that tensors larger than memory can be read; writes to
+// the tensor stay in memory
+template <auto... Vs, class... TIndices>
+auto map_file(const std::string &path, TIndices... extents) {
+  using extents_type = tt::extents_from<TIndices...>;
+  using element_type = tt::type_t<tt::dtypes, tt::dtype::Float32, Vs...>;
+  using layout_type = tt::type_t<tt::layouts, tt::layout::RowMajor, Vs...>;
+
+  return detail::map_tensor<element_type, layout_type>(
+      path, extents_type{extents...}, false);
+}
+
+// creates the file at path, or resizes it, to hold a tensor of the dtype and
+// layout whose elements it maps; writes to the tensor reach the file, and the
+// kernel writes them back as memory runs short
+template <auto... Vs, class... TIndices>
+auto create_file(const std::string &path, TIndices... extents) {
+  using extents_type = tt::extents_from<TIndices...>;
+  using element_type = tt::type_t<tt::dtypes, tt::dtype::Float32, Vs...>;
+  using layout_type = tt::type_t<tt::layouts, tt::layout::RowMajor, Vs...>;
+
+  return detail::map_tensor<element_type, layout_type>(
+      path, extents_type{extents...}, true);
+}
+
+// asks the kernel to start reading count elements at data in the background,
+// e.g. the next part of a mapped file; only a hint, which is ignored where it
+// is not supported
+template <class T>
+auto prefetch(const T *data, std::size_t count) noexcept -> void {
+#if defined(__unix__) or defined(__APPLE__)
+  static const auto page_size =
+      static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+
+  if (count == 0) {
+    return;
+  }
+
+  // madvise takes whole pages
+  const auto first =
+      reinterpret_cast<std::uintptr_t>(data) / page_size * page_size;
+  const auto last = reinterpret_cast<std::uintptr_t>(data + count);
+
+  ::madvise(reinterpret_cast<void *>(first), last - first, MADV_WILLNEED);
+#else
+  static_cast<void>(data);
+  static_cast<void>(count);
+#endif
+}
+
+} // namespace core
+} // namespace tt
@@ -1,64 +1,135 @@
 #pragma once
 
-#if __cplusplus >= 202002L
+#include <tt/core/detail/delete.hpp>
+#include <tt/core/memory_stats.hpp>
 
+#include <cstddef>
+#include <cstdlib>
 #include <memory>
+#include <new>
+#include <type_traits>
 
 namespace tt {
 inline namespace core {
+namespace detail {
 
-using std::make_shared;
-using std::make_shared_for_overwrite;
+// all-zero bytes are the value-initialized value of every trivial dtype, so
+// their buffers can come from std::calloc, which leaves large buffers to zero
+// pages the kernel maps on first touch instead of writing them
+template <class T>
+inline constexpr bool zero_initializable =
+    std::is_trivial_v<T> and alignof(T) <= alignof(std::max_align_t);
 
-} // namespace core
-} // namespace tt
+template <class T>
+auto make_shared_zeroed(std::size_t count, const detail::allocation &buffer)
+    -> std::shared_ptr<T[]> {
+  const auto pointer = static_cast<T *>(std::calloc(count, sizeof(T)));
 
-#else
+  if (pointer == nullptr and count > 0) {
+    throw std::bad_alloc{};
+  }
 
-#include <tt/core/detail/delete.hpp>
+  return {pointer, detail::free_delete{buffer}};
+}
 
-#include <memory>
-#include <type_traits>
+} // namespace detail
 
-namespace tt {
-inline namespace core {
+// unlike std::make_shared, each buffer is counted by tt::get_memory_stats()
+// until it is freed, and value-initialized buffers of trivial types are
+// zeroed lazily by the kernel
 
 template <class T>
-constexpr auto make_shared(std::size_t count) noexcept
+constexpr auto make_shared(std::size_t count)
     -> std::enable_if_t<std::is_array_v<T> and std::extent_v<T> == 0,
                         std::shared_ptr<T>> {
-  auto alloc = std::allocator<std::remove_extent_t<T>>{};
-  const auto pointer = alloc.allocate(count);
+  using element_type = std::remove_extent_t<T>;
+
+  if constexpr (detail::zero_initializable<element_type>) {
+    return detail::make_shared_zeroed<element_type>(
+        count, detail::allocation_of<element_type>(count));
+  } else {
+    auto alloc = std::allocator<element_type>{};
+    const auto pointer = alloc.allocate(count);
 
-  std::uninitialized_value_construct_n(pointer, count);
+    std::uninitialized_value_construct_n(pointer, count);
 
-  return {pointer, detail::allocator_delete{alloc, count}};
+    return {pointer,
+            detail::allocator_delete{
+                alloc, count, detail::allocation_of<element_type>(count)}};
+  }
 }
 
 template <class T>
 constexpr auto make_shared(std::size_t count,
-                           const std::remove_extent_t<T> &value) noexcept
+                           const std::remove_extent_t<T> &value)
     -> std::enable_if_t<std::is_array_v<T> and std::extent_v<T> == 0,
                         std::shared_ptr<T>> {
-  auto alloc = std::allocator<std::remove_extent_t<T>>{};
+  using element_type = std::remove_extent_t<T>;
+
+  auto alloc = std::allocator<element_type>{};
   const auto pointer = alloc.allocate(count);
 
   std::uninitialized_fill_n(pointer, count, value);
 
-  return {pointer, detail::allocator_delete{alloc, count}};
+  return {pointer,
+          detail::allocator_delete{
+              alloc, count, detail::allocation_of<element_type>(count)}};
 }
 
 template <class T>
-constexpr auto make_shared_for_overwrite(std::size_t count) noexcept
+constexpr auto make_shared_for_overwrite(std::size_t count)
     -> std::enable_if_t<std::is_array_v<T> and std::extent_v<T> == 0,
                         std::shared_ptr<T>> {
-  auto alloc = std::allocator<std::remove_extent_t<T>>{};
+  using element_type = std::remove_extent_t<T>;
+
+  auto alloc = std::allocator<element_type>{};
   const auto pointer = alloc.allocate(count);
 
-  return {pointer, detail::allocator_delete{alloc, count}};
+  return {pointer,
+          detail::allocator_delete{
+              alloc, count, detail::allocation_of<element_type>(count)}};
+}
+
+// buffer spanned by mapping, whose layout and padding are counted as well
+template <class T, class TMapping>
+constexpr auto make_shared(const TMapping &mapping)
+    -> std::enable_if_t<std::is_array_v<T> and std::extent_v<T> == 0 and
+                            not std::is_integral_v<TMapping>,
+                        std::shared_ptr<T>> {
+  using element_type = std::remove_extent_t<T>;
+
+  const std::size_t count = mapping.required_span_size();
+
+  if constexpr (detail::zero_initializable<element_type>) {
+    return detail::make_shared_zeroed<element_type>(
+        count, detail::allocation_of<element_type>(mapping));
+  } else {
+    auto alloc = std::allocator<element_type>{};
+    const auto pointer = alloc.allocate(count);
+
+    std::uninitialized_value_construct_n(pointer, count);
+
+    return {pointer,
+            detail::allocator_delete{
+                alloc, count, detail::allocation_of<element_type>(mapping)}};
+  }
+}
+
+template <class T, class TMapping>
+constexpr auto make_shared_for_overwrite(const TMapping &mapping)
+    -> std::enable_if_t<std::is_array_v<T> and std::extent_v<T> == 0 and
+                            not std::is_integral_v<TMapping>,
+                        std::shared_ptr<T>> {
+  using element_type = std::remove_extent_t<T>;
+
+  const std::size_t count = mapping.required_span_size();
+  auto alloc = std::allocator<element_type>{};
+  const auto pointer = alloc.allocate(count);
+
+  return {pointer,
+          detail::allocator_delete{
+              alloc, count, detail::allocation_of<element_type>(mapping)}};
 }
 
 } // namespace core
 } // namespace tt
-
-#endif
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <tt/core/dtype.hpp>
+#include <tt/core/layout.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+namespace tt {
+inline namespace core {
+namespace detail {
+
+inline constexpr std::size_t dtype_count =
+    static_cast<std::size_t>(tt::dtype::Bool) + 1;
+inline constexpr std::size_t layout_count =
+    static_cast<std::size_t>(tt::layout::TiledFaces) + 1;
+
+// what a buffer is charged to, kept by its deleter to undo the charge
+struct allocation {
+  std::size_t bytes = 0;
+  // elements spanned beyond the extents, such as those that pad a tiled
+  // layout out to whole tiles
+  std::size_t padding_bytes = 0;
+  std::optional<tt::dtype> dtype;
+  std::optional<tt::layout> layout;
+};
+
+template <class T>
+constexpr auto dtype_of() noexcept -> std::optional<tt::dtype> {
+  if constexpr (tt::has_dtype_v<T>) {
+    return tt::value_v<tt::dtypes, T>;
+  } else {
+    return std::nullopt;
+  }
+}
+
+template <class TLayout>
+constexpr auto layout_of() noexcept -> tt::layout {
+  if constexpr (not tt::is_tiled_layout_v<TLayout>) {
+    return tt::value_v<tt::layouts, TLayout>;
+  } else if constexpr (TLayout::face_height == TLayout::tile_height and
+                       TLayout::face_width == TLayout::tile_width) {
+    return tt::layout::Tiled;
+  } else {
+    return tt::layout::TiledFaces;
+  }
+}
+
+template <class T>
+constexpr auto allocation_of(std::size_t count) noexcept -> allocation {
+  return {count * sizeof(T), 0, detail::dtype_of<T>(), std::nullopt};
+}
+
+template <class T, class TMapping>
+constexpr auto allocation_of(const TMapping &mapping) noexcept -> allocation {
+  std::size_t size = 1;
+
+  for (std::size_t r = 0; r < TMapping::extents_type::rank(); ++r) {
+    size *= mapping.extents().extent(r);
+  }
+
+  const std::size_t count = mapping.required_span_size();
+
+  return {
+      count * sizeof(T),
+      (count - std::min(size, count)) * sizeof(T),
+      detail::dtype_of<T>(),
+      detail::layout_of<typename TMapping::layout_type>(),
+  };
+}
+
+struct memory_counters {
+  std::atomic<std::size_t> live_bytes{0};
+  std::atomic<std::size_t> peak_bytes{0};
+  std::atomic<std::size_t> allocations{0};
+  std::atomic<std::size_t> live_allocations{0};
+  std::atomic<std::size_t> padding_bytes{0};
+  std::array<std::atomic<std::size_t>, dtype_count> live_bytes_by_dtype{};
+  std::array<std::atomic<std::size_t>, layout_count> live_bytes_by_layout{};
+};
+
+inline auto get_memory_counters() -> memory_counters & {
+  static memory_counters counters;
+  return counters;
+}
+
+inline auto charge(const allocation &buffer) noexcept -> void {
+  auto &counters = detail::get_memory_counters();
+  const auto live = counters.live_bytes.fetch_add(
+                        buffer.bytes, std::memory_order_relaxed) +
+                    buffer.bytes;
+  auto peak = counters.peak_bytes.load(std::memory_order_relaxed);
+
+  while (peak < live and not counters.peak_bytes.compare_exchange_weak(
+                             peak, live, std::memory_order_relaxed)) {
+  }
+
+  counters.allocations.fetch_add(1, std::memory_order_relaxed);
+  counters.live_allocations.fetch_add(1, std::memory_order_relaxed);
+  counters.padding_bytes.fetch_add(buffer.padding_bytes,
+                                   std::memory_order_relaxed);
+
+  if (buffer.dtype) {
+    counters.live_bytes_by_dtype[static_cast<std::size_t>(*buffer.dtype)]
+        .fetch_add(buffer.bytes, std::memory_order_relaxed);
+  }
+
+  if (buffer.layout) {
+    counters.live_bytes_by_layout[static_cast<std::size_t>(*buffer.layout)]
+        .fetch_add(buffer.bytes, std::memory_order_relaxed);
+  }
+}
+
+inline auto discharge(const allocation &buffer) noexcept -> void {
+  auto &counters = detail::get_memory_counters();
+
+  counters.live_bytes.fetch_sub(buffer.bytes, std::memory_order_relaxed);
+  counters.live_allocations.fetch_sub(1, std::memory_order_relaxed);
+  counters.padding_bytes.fetch_sub(buffer.padding_bytes,
+                                   std::memory_order_relaxed);
+
+  if (buffer.dtype) {
+    counters.live_bytes_by_dtype[static_cast<std::size_t>(*buffer.dtype)]
+        .fetch_sub(buffer.bytes, std::memory_order_relaxed);
+  }
+
+  if (buffer.layout) {
+    counters.live_bytes_by_layout[static_cast<std::size_t>(*buffer.layout)]
+        .fetch_sub(buffer.bytes, std::memory_order_relaxed);
+  }
+}
+
+} // namespace detail
+
+// buffers allocated by tt::make_shared and tt::make_shared_for_overwrite;
+// live counts are of buffers not yet freed
+struct memory_stats {
+  std::size_t live_bytes = 0;
+  // most live bytes since the process started or the last reset
+  std::size_t peak_bytes = 0;
+  std::size_t allocations = 0;
+  std::size_t live_allocations = 0;
+  // live bytes that pad tiled layouts out to whole tiles
+  std::size_t padding_bytes = 0;
+  // indexed by tt::dtype
+  std::array<std::size_t, detail::dtype_count> live_bytes_by_dtype{};
+  // indexed by tt::layout, for buffers allocated for a mapping
+  std::array<std::size_t, detail::layout_count> live_bytes_by_layout{};
+};
+
+inline auto get_memory_stats() noexcept -> tt::memory_stats {
+  const auto &counters = detail::get_memory_counters();
+  tt::memory_stats stats{
+      counters.live_bytes.load(std::memory_order_relaxed),
+      counters.peak_bytes.load(std::memory_order_relaxed),
+      counters.allocations.load(std::memory_order_relaxed),
+      counters.live_allocations.load(std::memory_order_relaxed),
+      counters.padding_bytes.load(std::memory_order_relaxed),
+  };
+
+  for (std::size_t index = 0; index < detail::dtype_count; ++index) {
+    stats.live_bytes_by_dtype[index] =
+        counters.live_bytes_by_dtype[index].load(std::memory_order_relaxed);
+  }
+
+  for (std::size_t index = 0; index < detail::layout_count; ++index) {
+    stats.live_bytes_by_layout[index] =
+        counters.live_bytes_by_layout[index].load(std::memory_order_relaxed);
+  }
+
+  return stats;
+}
+
+// restarts the peak from the bytes live now
+inline auto reset_peak_memory_stats() noexcept -> void {
+  auto &counters = detail::get_memory_counters();
+
+  counters.peak_bytes.store(
+      counters.live_bytes.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
+}
+
+} // namespace core
+} // namespace tt
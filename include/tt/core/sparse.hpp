@@ -0,0 +1,138 @@
+#pragma once
+
+#include <tt/core/concepts.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace tt {
+inline namespace core {
+
+// compressed sparse rows: the stored elements of each row follow those of the
+// rows before it, so that row r holds elements [row_offsets[r],
+// row_offsets[r + 1]) of columns and values
+template <class T>
+class csr_matrix {
+public:
+  using element_type = T;
+  using extents_type = tt::dims<2>;
+  using index_type = std::size_t;
+
+private:
+  extents_type exts;
+  // extent(0) + 1 offsets, the last of which is the stored element count
+  std::shared_ptr<index_type[]> offsets;
+  std::shared_ptr<index_type[]> cols;
+  std::shared_ptr<T[]> vals;
+
+public:
+  csr_matrix(const extents_type &exts, std::shared_ptr<index_type[]> offsets,
+             std::shared_ptr<index_type[]> cols,
+             std::shared_ptr<T[]> vals) noexcept
+      : exts(exts), offsets(std::move(offsets)), cols(std::move(cols)),
+        vals(std::move(vals)) {}
+
+  static constexpr auto rank() noexcept -> std::size_t { return 2; }
+
+  auto extents() const noexcept -> const extents_type & { return exts; }
+
+  auto extent(std::size_t r) const noexcept -> index_type {
+    return exts.extent(r);
+  }
+
+  // stored elements, which may include explicit zeros
+  auto nnz() const noexcept -> index_type { return offsets[exts.extent(0)]; }
+
+  auto row_offsets() const noexcept -> const std::shared_ptr<index_type[]> & {
+    return offsets;
+  }
+
+  auto columns() const noexcept -> const std::shared_ptr<index_type[]> & {
+    return cols;
+  }
+
+  auto values() const noexcept -> const std::shared_ptr<T[]> & {
+    return vals;
+  }
+};
+
+// coordinate list: the row, column and value of each stored element, in
+// row-major order
+template <class T>
+class coo_matrix {
+public:
+  using element_type = T;
+  using extents_type = tt::dims<2>;
+  using index_type = std::size_t;
+
+private:
+  extents_type exts;
+  index_type count;
+  std::shared_ptr<index_type[]> row_indices;
+  std::shared_ptr<index_type[]> cols;
+  std::shared_ptr<T[]> vals;
+
+public:
+  coo_matrix(const extents_type &exts, index_type count,
+             std::shared_ptr<index_type[]> row_indices,
+             std::shared_ptr<index_type[]> cols,
+             std::shared_ptr<T[]> vals) noexcept
+      : exts(exts), count(count), row_indices(std::move(row_indices)),
+        cols(std::move(cols)), vals(std::move(vals)) {
+    assert(this->is_sorted());
+  }
+
+  static constexpr auto rank() noexcept -> std::size_t { return 2; }
+
+  auto extents() const noexcept -> const extents_type & { return exts; }
+
+  auto extent(std::size_t r) const noexcept -> index_type {
+    return exts.extent(r);
+  }
+
+  auto nnz() const noexcept -> index_type { return count; }
+
+  auto rows() const noexcept -> const std::shared_ptr<index_type[]> & {
+    return row_indices;
+  }
+
+  auto columns() const noexcept -> const std::shared_ptr<index_type[]> & {
+    return cols;
+  }
+
+  auto values() const noexcept -> const std::shared_ptr<T[]> & {
+    return vals;
+  }
+
+  auto is_sorted() const noexcept -> bool {
+    for (index_type index = 1; index < count; ++index) {
+      if (row_indices[index] < row_indices[index - 1] or
+          (row_indices[index] == row_indices[index - 1] and
+           cols[index] <= cols[index - 1])) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+};
+
+template <class T>
+inline constexpr bool is_csr_v = false;
+
+template <class T>
+inline constexpr bool is_csr_v<tt::csr_matrix<T>> = true;
+
+template <class T>
+inline constexpr bool is_coo_v = false;
+
+template <class T>
+inline constexpr bool is_coo_v<tt::coo_matrix<T>> = true;
+
+template <class T>
+inline constexpr bool sparse = tt::is_csr_v<T> or tt::is_coo_v<T>;
+
+} // namespace core
+} // namespace tt
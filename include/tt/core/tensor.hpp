@@ -1,5 +1,6 @@
 #pragma once
 
+#include <tt/core/borrowed_accessor.hpp>
 #include <tt/core/concepts.hpp>
 #include <tt/core/layout.hpp>
 #include <tt/core/shared_accessor.hpp>
@@ -11,6 +12,11 @@ template <class T, class TExtents, class TLayout,
           class = std::enable_if_t<tt::arithmetic<T> and tt::extents<TExtents>>>
 using Tensor = std::mdspan<T, TExtents, TLayout, tt::shared_accessor<T>>;
 
+template <class T, class TExtents, class TLayout,
+          class = std::enable_if_t<tt::arithmetic<T> and tt::extents<TExtents>>>
+using BorrowedTensor =
+    std::mdspan<T, TExtents, TLayout, tt::borrowed_accessor<T>>;
+
 template <class T, class TExtents>
 using RowMajorTensor = tt::Tensor<T, TExtents, tt::RowMajor>;
 
@@ -22,6 +28,17 @@ template <class T, class TExtents = tt::dims<2>,
           class = std::enable_if_t<tt::has_rank<TExtents, 2>>>
 using RowMajorMatrix = tt::RowMajorTensor<T, TExtents>;
 
+template <class T, class TExtents>
+using ColMajorTensor = tt::Tensor<T, TExtents, tt::ColMajor>;
+
+template <class T, class TExtents = tt::dims<1>,
+          class = std::enable_if_t<tt::has_rank<TExtents, 1>>>
+using ColMajorVector = tt::ColMajorTensor<T, TExtents>;
+
+template <class T, class TExtents = tt::dims<2>,
+          class = std::enable_if_t<tt::has_rank<TExtents, 2>>>
+using ColMajorMatrix = tt::ColMajorTensor<T, TExtents>;
+
 template <class T, class TExtents>
 using TiledTensor = tt::Tensor<T, TExtents, tt::Tiled>;
 
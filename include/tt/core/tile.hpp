@@ -0,0 +1,265 @@
+#pragma once
+
+#include <tt/core/borrow.hpp>
+#include <tt/core/concepts.hpp>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <tuple>
+
+namespace tt {
+inline namespace core {
+
+template <class T, class TLayout, std::size_t BatchRank>
+struct tile {
+  using element_type = T;
+  using layout_type = TLayout;
+  using index_type = std::size_t;
+  using batch_type = std::array<index_type, BatchRank>;
+
+  static constexpr index_type height = TLayout::tile_height;
+  static constexpr index_type width = TLayout::tile_width;
+  static constexpr index_type face_height = TLayout::face_height;
+  static constexpr index_type face_width = TLayout::face_width;
+
+  // first of tile_size contiguous elements
+  T *data;
+  // indices of the extents preceding the two innermost extents
+  batch_type batch;
+  // logical origin of the tile within its matrix
+  index_type row;
+  index_type col;
+  // logical extent of the tile, smaller than height and width at the edges
+  index_type rows;
+  index_type cols;
+
+  static constexpr auto size() noexcept -> index_type {
+    return TLayout::tile_size;
+  }
+
+  constexpr auto begin() const noexcept -> T * { return data; }
+
+  constexpr auto end() const noexcept -> T * { return data + size(); }
+
+  constexpr auto operator()(index_type r,
+                            index_type c) const noexcept -> T & {
+    return data[TLayout::offset_in_tile(r, c)];
+  }
+
+  // first of the face_height x face_width row-major elements of the face in
+  // face row r and face column c
+  constexpr auto face(index_type r, index_type c) const noexcept -> T * {
+    return data + TLayout::offset_in_tile(r * face_height, c * face_width);
+  }
+
+  // element of another tensor with the same extents at (r, c) of this tile
+  template <class TInput>
+  constexpr auto at(const TInput &input, index_type r, index_type c) const
+      -> std::enable_if_t<tt::tensor<TInput>, tt::reference_t<TInput>> {
+    constexpr auto rank = TInput::rank();
+
+    if constexpr (rank == 0) {
+      return input();
+    } else if constexpr (rank == 1) {
+      return input(col + c);
+    } else {
+      static_assert(rank - 2 == BatchRank);
+
+      return std::apply(
+          [&](auto... indices) -> tt::reference_t<TInput> {
+            return input(indices..., row + r, col + c);
+          },
+          batch);
+    }
+  }
+};
+
+template <class TInput, class = std::enable_if_t<tt::tiled<TInput>>>
+using tile_type_t =
+    tt::tile<tt::element_type_t<TInput>, tt::layout_type_t<TInput>,
+             (TInput::rank() >= 2 ? TInput::rank() - 2 : 0)>;
+
+template <class TTile>
+struct tile_range {
+  using index_type = typename TTile::index_type;
+  using batch_type = typename TTile::batch_type;
+
+private:
+  typename TTile::element_type *data;
+  batch_type batch_extents;
+  index_type tile_rows;
+  index_type tile_cols;
+  index_type rows;
+  index_type cols;
+
+public:
+  struct iterator {
+    using iterator_category = std::input_iterator_tag;
+    using value_type = TTile;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = TTile;
+
+    const tile_range *range;
+    index_type index;
+
+    constexpr auto operator*() const noexcept -> reference {
+      return (*range)[index];
+    }
+
+    constexpr auto operator++() noexcept -> iterator & {
+      ++index;
+      return *this;
+    }
+
+    constexpr auto operator++(int) noexcept -> iterator {
+      const auto previous_value = *this;
+      ++*this;
+      return previous_value;
+    }
+
+    constexpr auto operator==(const iterator &rhs) const noexcept -> bool {
+      return index == rhs.index;
+    }
+
+    constexpr auto operator!=(const iterator &rhs) const noexcept -> bool {
+      return index != rhs.index;
+    }
+  };
+
+  constexpr tile_range(typename TTile::element_type *data,
+                       const batch_type &batch_extents, index_type tile_rows,
+                       index_type tile_cols, index_type rows,
+                       index_type cols) noexcept
+      : data(data), batch_extents(batch_extents), tile_rows(tile_rows),
+        tile_cols(tile_cols), rows(rows), cols(cols) {}
+
+  constexpr auto matrices() const noexcept -> index_type {
+    index_type value = 1;
+
+    for (const auto extent : batch_extents) {
+      value *= extent;
+    }
+
+    return value;
+  }
+
+  constexpr auto size() const noexcept -> index_type {
+    return this->matrices() * tile_rows * tile_cols;
+  }
+
+  constexpr auto begin() const noexcept -> iterator { return {this, 0}; }
+
+  constexpr auto end() const noexcept -> iterator {
+    return {this, this->size()};
+  }
+
+  constexpr auto operator[](index_type index) const noexcept -> TTile {
+    const auto tiles_per_matrix = tile_rows * tile_cols;
+    const auto tile_index = index % tiles_per_matrix;
+    const auto row = (tile_index / tile_cols) * TTile::height;
+    const auto col = (tile_index % tile_cols) * TTile::width;
+
+    batch_type batch{};
+
+    for (auto matrix = index / tiles_per_matrix, r = batch.size(); r-- > 0;) {
+      batch[r] = matrix % batch_extents[r];
+      matrix /= batch_extents[r];
+    }
+
+    return {
+        data + index * TTile::size(),
+        batch,
+        row,
+        col,
+        std::min(TTile::height, rows - row),
+        std::min(TTile::width, cols - col),
+    };
+  }
+
+  // visits the tiles in [first, last) in storage order, dividing only to
+  // locate the first one
+  template <class TCallback>
+  constexpr auto for_each(index_type first, index_type last,
+                          TCallback callback) const -> void {
+    if (first >= last) {
+      return;
+    }
+
+    const auto tiles_per_matrix = tile_rows * tile_cols;
+    const auto origin = (*this)[first];
+    auto tile_data = origin.data;
+    auto batch = origin.batch;
+    auto tile_row = (first % tiles_per_matrix) / tile_cols;
+    auto tile_col = first % tile_cols;
+
+    for (auto index = first; index < last; ++index) {
+      const auto row = tile_row * TTile::height;
+      const auto col = tile_col * TTile::width;
+
+      callback(TTile{tile_data, batch, row, col,
+                     std::min(TTile::height, rows - row),
+                     std::min(TTile::width, cols - col)});
+      tile_data += TTile::size();
+
+      if (++tile_col < tile_cols) {
+        continue;
+      }
+
+      tile_col = 0;
+
+      if (++tile_row < tile_rows) {
+        continue;
+      }
+
+      tile_row = 0;
+
+      for (auto r = batch.size(); r-- > 0;) {
+        if (++batch[r] < batch_extents[r]) {
+          break;
+        }
+
+        batch[r] = 0;
+      }
+    }
+  }
+
+  template <class TCallback>
+  constexpr auto for_each(TCallback callback) const -> void {
+    this->for_each(0, this->size(), callback);
+  }
+};
+
+template <class TInput, class = std::enable_if_t<tt::tiled<TInput>>>
+constexpr auto tiles(const TInput &input) {
+  using tile_type = tt::tile_type_t<TInput>;
+  using batch_type = typename tile_type::batch_type;
+
+  constexpr auto rank = TInput::rank();
+
+  const auto &mapping = input.mapping();
+  batch_type batch_extents{};
+
+  for (std::size_t r = 0; r < batch_extents.size(); ++r) {
+    batch_extents[r] = input.extent(r);
+  }
+
+  return tt::tile_range<tile_type>{
+      tt::borrow(input).data_handle(),
+      batch_extents,
+      mapping.tile_rows(),
+      mapping.tile_cols(),
+      rank >= 2 ? input.extent(rank - 2) : 1,
+      rank >= 1 ? input.extent(rank - 1) : 1,
+  };
+}
+
+template <class TInput, class TCallback,
+          class = std::enable_if_t<tt::tiled<TInput>>>
+constexpr auto for_each_tile(const TInput &input, TCallback callback) -> void {
+  tt::tiles(input).for_each(callback);
+}
+
+} // namespace core
+} // namespace tt
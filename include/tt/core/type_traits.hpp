@@ -16,6 +16,13 @@ inline constexpr bool is_extents_v = false;
 template <class TIndex, auto... Extents>
 inline constexpr bool is_extents_v<std::extents<TIndex, Extents...>> = true;
 
+template <class T, class = void>
+inline constexpr bool is_tiled_layout_v = false;
+
+template <class T>
+inline constexpr bool
+    is_tiled_layout_v<T, std::void_t<decltype(T::tile_size)>> = true;
+
 template <class T>
 inline constexpr bool is_tensor_v = false;
 
@@ -23,9 +30,18 @@ template <class TElement, class TExtents, class TLayout, class TAccessor>
 inline constexpr bool
     is_tensor_v<std::mdspan<TElement, TExtents, TLayout, TAccessor>> = true;
 
+template <class T>
+using accessor_type_t = typename T::accessor_type;
+
+template <class T>
+using data_handle_type_t = typename T::data_handle_type;
+
 template <class T>
 using element_type_t = typename T::element_type;
 
+template <class T>
+using reference_t = typename T::reference;
+
 template <class... Ts>
 using common_element_type_t = std::common_type_t<tt::element_type_t<Ts>...>;
 
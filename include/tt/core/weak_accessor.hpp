@@ -1,5 +1,6 @@
 #pragma once
 
+#include <tt/core/layout.hpp>
 #include <tt/core/offset_policy.hpp>
 
 #include <cassert>
@@ -49,5 +50,18 @@ struct weak_accessor {
   }
 };
 
+template <class T>
+inline constexpr bool is_weak_v = false;
+
+template <class TElement, class TExtents, class TLayout>
+inline constexpr bool is_weak_v<
+    std::mdspan<TElement, TExtents, TLayout, tt::weak_accessor<TElement>>> =
+    true;
+
+// tensor that does not keep its buffer alive, which tt::lock() turns into one
+// that does
+template <class T>
+inline constexpr bool weak = tt::is_weak_v<T>;
+
 } // namespace core
 } // namespace tt
@@ -1,7 +1,14 @@
 #pragma once
 
+#include <tt/core/borrow.hpp>
 #include <tt/core/dtype.hpp>
+#include <tt/core/generator_accessor.hpp>
 #include <tt/operators/empty.hpp>
+#include <tt/runtime/layout_cache.hpp>
+#include <tt/runtime/parallel_for.hpp>
+#include <tt/runtime/profiler.hpp>
+
+#include <cassert>
 
 namespace tt {
 inline namespace operators {
@@ -14,13 +21,20 @@ constexpr auto arange(TStart start, TEnd end, TStep step) {
 
   constexpr auto dtype = tt::value_v<tt::dtypes, element_type>;
 
+  tt::profile_scope scope{"arange"};
   const std::size_t size =
       static_cast<element_type>(end - start - 1) / step + 1;
   const auto result = tt::empty<dtype>(size);
+  const auto result_view = tt::borrow(result);
+
+  tt::parallel_for(0, size, tt::default_grain_size,
+                   [&](std::size_t first, std::size_t last) {
+                     for (auto index = first; index < last; ++index) {
+                       result_view[index] = start + index * step;
+                     }
+                   });
 
-  for (std::size_t index = 0; index < size; ++index) {
-    result[index] = start + index * step;
-  }
+  scope.output(result);
 
   return result;
 }
@@ -37,5 +51,81 @@ constexpr auto arange(TEnd end) {
   return arange<Vs...>(start, end);
 }
 
+// writes the same elements into an existing vector of the dtype of the
+// output, whose extent must be their count
+template <class TOutput, class TStart, class TEnd, class TStep,
+          class = std::enable_if_t<tt::writable<TOutput> and
+                                   tt::vector<TOutput>>>
+auto arange_out(const TOutput &output, TStart start, TEnd end, TStep step)
+    -> TOutput {
+  using element_type = tt::element_type_t<TOutput>;
+
+  tt::profile_scope scope{"arange"};
+  const std::size_t size =
+      static_cast<element_type>(end - start - 1) / step + 1;
+  const auto output_view = tt::borrow(output);
+
+  assert(output.extent(0) == size);
+
+  tt::parallel_for(0, size, tt::default_grain_size,
+                   [&](std::size_t first, std::size_t last) {
+                     for (auto index = first; index < last; ++index) {
+                       output_view[index] = start + index * step;
+                     }
+                   });
+
+  tt::get_layout_cache().invalidate(output);
+  scope.output(output);
+
+  return output;
+}
+
+template <class TOutput, class TStart, class TEnd>
+auto arange_out(const TOutput &output, TStart start, TEnd end) -> TOutput {
+  constexpr std::common_type_t<TStart, TEnd> step{1};
+  return tt::arange_out(output, start, end, step);
+}
+
+template <class TOutput, class TEnd>
+auto arange_out(const TOutput &output, TEnd end) -> TOutput {
+  constexpr TEnd start{0};
+  return tt::arange_out(output, start, end);
+}
+
+namespace lazy {
+
+// same elements as tt::arange, computed from their index when read instead of
+// stored; materialize with e.g. tt::to_row_major()
+template <auto... Vs, class TStart, class TEnd, class TStep>
+constexpr auto arange(TStart start, TEnd end, TStep step) {
+  using common_type = std::common_type_t<TStart, TEnd, TStep>;
+  using element_type =
+      tt::type_t<tt::dtypes, tt::value_v<tt::dtypes, common_type>, Vs...>;
+  using generator_type = tt::affine_generator<element_type, common_type>;
+  using output_type = tt::GeneratedTensor<generator_type, tt::dims<1>>;
+
+  const std::size_t size =
+      static_cast<element_type>(end - start - 1) / step + 1;
+
+  return output_type{
+      tt::generator_handle<generator_type>{
+          {common_type(start), common_type(step)}},
+      tt::dims<1>{size},
+  };
+}
+
+template <auto... Vs, class TStart, class TEnd>
+constexpr auto arange(TStart start, TEnd end) {
+  constexpr std::common_type_t<TStart, TEnd> step{1};
+  return lazy::arange<Vs...>(start, end, step);
+}
+
+template <auto... Vs, class TEnd>
+constexpr auto arange(TEnd end) {
+  constexpr TEnd start{0};
+  return lazy::arange<Vs...>(start, end);
+}
+
+} // namespace lazy
 } // namespace operators
 } // namespace tt
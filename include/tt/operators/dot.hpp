@@ -1,9 +1,30 @@
 #pragma once
 
+#include <tt/core/borrow.hpp>
 #include <tt/core/concepts.hpp>
+#include <tt/core/inline_accessor.hpp>
+#include <tt/runtime/parallel_for.hpp>
+#include <tt/runtime/profiler.hpp>
+
+#include <functional>
+#include <utility>
 
 namespace tt {
 inline namespace operators {
+namespace detail {
+namespace {
+
+// sum of products over the static extent of fixed-size vectors, unrolled
+// instead of scheduled
+template <class TResult, class TLhs, class TRhs, std::size_t... Indices>
+constexpr auto dot_fixed(const TLhs &lhs, const TRhs &rhs,
+                         std::index_sequence<Indices...>) noexcept
+    -> TResult {
+  return (TResult{} + ... + (lhs[Indices] * rhs[Indices]));
+}
+
+} // namespace
+} // namespace detail
 
 template <class TLhs, class TRhs, class = void>
 inline constexpr bool has_dot_product = false;
@@ -24,14 +45,30 @@ template <class TLhs, class TRhs>
 constexpr auto dot(const TLhs &lhs, const TRhs &rhs) {
   assert(lhs.size() == rhs.size());
 
-  const auto size = lhs.size();
-  tt::dot_product_result_t<TLhs, TRhs> result{};
+  using result_type = tt::dot_product_result_t<TLhs, TRhs>;
 
-  for (std::size_t index = 0; index < size; ++index) {
-    result += lhs[index] * rhs[index];
-  }
+  if constexpr (tt::fixed_size<TLhs> and tt::fixed_size<TRhs>) {
+    return detail::dot_fixed<result_type>(
+        lhs, rhs, std::make_index_sequence<TLhs::static_extent(0)>{});
+  } else {
+    const tt::profile_scope scope{"dot", lhs, rhs};
+    const auto size = lhs.size();
+    const auto lhs_view = tt::borrow(lhs);
+    const auto rhs_view = tt::borrow(rhs);
+
+    return tt::parallel_reduce(
+        0, size, tt::default_grain_size, result_type{},
+        [&](std::size_t first, std::size_t last) {
+          result_type result{};
 
-  return result;
+          for (auto index = first; index < last; ++index) {
+            result += lhs_view[index] * rhs_view[index];
+          }
+
+          return result;
+        },
+        std::plus<>{});
+  }
 }
 
 } // namespace operators
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <tt/core/borrow.hpp>
 #include <tt/core/dtype.hpp>
 #include <tt/core/float.hpp>
 #include <tt/core/layout.hpp>
 #include <tt/core/memory.hpp>
 #include <tt/core/tensor.hpp>
+#include <tt/runtime/layout_cache.hpp>
+#include <tt/runtime/profiler.hpp>
 
 namespace tt {
 inline namespace operators {
@@ -14,13 +17,27 @@ constexpr auto empty(TIndices... extents) {
   using extents_type = tt::extents_from<TIndices...>;
   using element_type = tt::type_t<tt::dtypes, tt::dtype::Float32, Vs...>;
   using layout_type = tt::type_t<tt::layouts, tt::layout::RowMajor, Vs...>;
+  using output_type = tt::Tensor<element_type, extents_type, layout_type>;
 
+  tt::profile_scope scope{"empty"};
   const typename layout_type::template mapping<extents_type> mapping{
       extents_type{extents...}};
-  const auto size = mapping.required_span_size();
+  const output_type output{
+      tt::make_shared_for_overwrite<element_type[]>(mapping), mapping};
 
-  return tt::Tensor<element_type, extents_type, layout_type>{
-      tt::make_shared_for_overwrite<element_type[]>(size), mapping};
+  scope.output(output);
+
+  return output;
+}
+
+// hands back an existing tensor for the caller to overwrite, so that code
+// written against tt::empty can reuse a buffer instead
+template <class TOutput, class = std::enable_if_t<tt::writable<TOutput>>>
+auto empty_out(const TOutput &output) -> TOutput {
+  // whatever was converted from the buffer is about to be overwritten
+  tt::get_layout_cache().invalidate(output);
+
+  return output;
 }
 
 } // namespace operators
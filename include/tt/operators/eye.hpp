@@ -1,6 +1,11 @@
 #pragma once
 
+#include <tt/core/borrow.hpp>
+#include <tt/core/generator_accessor.hpp>
 #include <tt/operators/zeros.hpp>
+#include <tt/runtime/layout_cache.hpp>
+#include <tt/runtime/parallel_for.hpp>
+#include <tt/runtime/profiler.hpp>
 
 namespace tt {
 inline namespace operators {
@@ -10,12 +15,19 @@ constexpr auto eye(TRows rows, TCols cols) {
   using element_type = tt::type_t<tt::dtypes, tt::dtype::Float32, Vs...>;
 
   constexpr element_type one{1};
+  tt::profile_scope scope{"eye"};
   const auto result = zeros<Vs...>(rows, cols);
+  const auto result_view = tt::borrow(result);
   const auto diagonal_size = std::min<std::size_t>(rows, cols);
 
-  for (std::size_t index = 0; index < diagonal_size; ++index) {
-    result(index, index) = one;
-  }
+  tt::parallel_for(0, diagonal_size, tt::default_grain_size,
+                   [&](std::size_t first, std::size_t last) {
+                     for (auto index = first; index < last; ++index) {
+                       result_view(index, index) = one;
+                     }
+                   });
+
+  scope.output(result);
 
   return result;
 }
@@ -25,5 +37,84 @@ constexpr auto eye(TIndex extent) {
   return eye<Vs...>(extent, extent);
 }
 
+// writes the identity into an existing matrix, zeroing it first
+template <class TOutput, class = std::enable_if_t<tt::writable<TOutput> and
+                                                  tt::matrix<TOutput>>>
+auto eye_out(const TOutput &output) -> TOutput {
+  using element_type = tt::element_type_t<TOutput>;
+
+  constexpr element_type one{1};
+  tt::profile_scope scope{"eye"};
+  const auto output_view = tt::borrow(tt::zeros_out(output));
+  const auto diagonal_size =
+      std::min<std::size_t>(output.extent(0), output.extent(1));
+
+  tt::parallel_for(0, diagonal_size, tt::default_grain_size,
+                   [&](std::size_t first, std::size_t last) {
+                     for (auto index = first; index < last; ++index) {
+                       output_view(index, index) = one;
+                     }
+                   });
+
+  // zeros_out() invalidated before the diagonal was written
+  tt::get_layout_cache().invalidate(output);
+  scope.output(output);
+
+  return output;
+}
+
+namespace lazy {
+
+// same elements as tt::eye, computed from their index when read instead of
+// stored
+template <auto... Vs, class TRows, class TCols>
+constexpr auto eye(TRows rows, TCols cols) {
+  using element_type = tt::type_t<tt::dtypes, tt::dtype::Float32, Vs...>;
+  using extents_type = tt::extents_from<TRows, TCols>;
+  using generator_type = tt::diagonal_generator<element_type>;
+  using output_type = tt::GeneratedTensor<generator_type, extents_type>;
+
+  const std::size_t row_count = rows;
+  const std::size_t col_count = cols;
+
+  return output_type{
+      tt::generator_handle<generator_type>{
+          {col_count + 1, std::min(row_count, col_count)}},
+      extents_type{rows, cols},
+  };
+}
+
+template <auto... Vs, class TIndex>
+constexpr auto eye(TIndex extent) {
+  return lazy::eye<Vs...>(extent, extent);
+}
+
+} // namespace lazy
+
+namespace fixed {
+
+template <auto... Vs, class TRows, class TCols>
+constexpr auto eye(TRows rows, TCols cols) noexcept {
+  using element_type = tt::type_t<tt::dtypes, tt::dtype::Float32, Vs...>;
+
+  using output_type = decltype(fixed::zeros<Vs...>(rows, cols));
+
+  typename output_type::data_handle_type data{};
+  const typename output_type::mapping_type mapping{};
+
+  for (std::size_t index = 0; index < std::min<std::size_t>(rows, cols);
+       ++index) {
+    data.values[mapping(index, index)] = element_type{1};
+  }
+
+  return output_type{data};
+}
+
+template <auto... Vs, class TIndex>
+constexpr auto eye(TIndex extent) noexcept {
+  return fixed::eye<Vs...>(extent, extent);
+}
+
+} // namespace fixed
 } // namespace operators
 } // namespace tt
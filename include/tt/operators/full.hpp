@@ -1,24 +1,126 @@
 #pragma once
 
+#include <tt/core/borrow.hpp>
 #include <tt/core/dtype.hpp>
+#include <tt/core/generator_accessor.hpp>
+#include <tt/core/inline_accessor.hpp>
 #include <tt/core/memory.hpp>
 #include <tt/core/tensor.hpp>
+#include <tt/runtime/layout_cache.hpp>
+#include <tt/runtime/parallel_for.hpp>
+#include <tt/runtime/profiler.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
 
 namespace tt {
 inline namespace operators {
+namespace detail {
+namespace {
+
+// sets every element in the span of output, padding of tiles included, which
+// must not have gaps that hold elements of other tensors
+template <class TOutput, class T>
+auto fill_span(const TOutput &output, const T &value) -> void {
+  assert(output.is_exhaustive() or tt::tiled<TOutput>);
+
+  const auto data = tt::borrow(output).data_handle();
+
+  tt::parallel_for(0, output.mapping().required_span_size(),
+                   tt::default_grain_size,
+                   [&](std::size_t first, std::size_t last) {
+                     std::fill(data + first, data + last, value);
+                   });
+}
+
+} // namespace
+} // namespace detail
+
+template <auto... Vs, class T, class... TIndices>
+constexpr auto full(T fill_value, TIndices... extents) {
+  constexpr auto default_dtype = tt::value_v<tt::dtypes, T>;
+  using element_type = tt::type_t<tt::dtypes, default_dtype, Vs...>;
+  using extents_type = tt::extents_from<TIndices...>;
+  using layout_type = tt::type_t<tt::layouts, tt::layout::RowMajor, Vs...>;
+  using output_type = tt::Tensor<element_type, extents_type, layout_type>;
+
+  tt::profile_scope scope{"full"};
+  const typename layout_type::template mapping<extents_type> mapping{
+      extents_type{extents...}};
+  const auto size = mapping.required_span_size();
+  const auto data = tt::make_shared_for_overwrite<element_type[]>(mapping);
+  const element_type value(fill_value);
+
+  tt::parallel_for(0, size, tt::default_grain_size,
+                   [&](std::size_t first, std::size_t last) {
+                     std::uninitialized_fill(data.get() + first,
+                                             data.get() + last, value);
+                   });
+
+  const output_type output{data, mapping};
+
+  scope.output(output);
 
+  return output;
+}
+
+// fills an existing tensor instead of allocating one, e.g. to reuse the
+// buffer of a tensor that is no longer needed
+template <class TOutput, class T,
+          class = std::enable_if_t<tt::writable<TOutput>>>
+auto full_out(const TOutput &output, T fill_value) -> TOutput {
+  tt::profile_scope scope{"full"};
+
+  detail::fill_span(output, tt::element_type_t<TOutput>(fill_value));
+  tt::get_layout_cache().invalidate(output);
+  scope.output(output);
+
+  return output;
+}
+
+namespace lazy {
+
+// row-major tensor of fill_value that stores nothing, e.g. to broadcast a
+// scalar into another operator
 template <auto... Vs, class T, class... TIndices>
 constexpr auto full(T fill_value, TIndices... extents) {
+  constexpr auto default_dtype = tt::value_v<tt::dtypes, T>;
+  using element_type = tt::type_t<tt::dtypes, default_dtype, Vs...>;
+  using extents_type = tt::extents_from<TIndices...>;
+  using generator_type = tt::constant_generator<element_type>;
+  using output_type = tt::GeneratedTensor<generator_type, extents_type>;
+
+  return output_type{
+      tt::generator_handle<generator_type>{{element_type(fill_value)}},
+      extents_type{extents...},
+  };
+}
+
+} // namespace lazy
+
+namespace fixed {
+
+// same elements as tt::full, held by value for extents that are all integral
+// constants
+template <auto... Vs, class T, class... TIndices>
+constexpr auto full(T fill_value, TIndices...) noexcept {
   constexpr auto default_dtype = tt::value_v<tt::dtypes, T>;
   using element_type = tt::type_t<tt::dtypes, default_dtype, Vs...>;
   using extents_type = tt::extents_from<TIndices...>;
   using layout_type = tt::type_t<tt::layouts, tt::layout::RowMajor, Vs...>;
+  using output_type =
+      tt::InlineTensor<element_type, extents_type, layout_type>;
+
+  typename output_type::data_handle_type data{};
 
-  const std::size_t size = (1 * ... * extents);
+  for (auto &value : data.values) {
+    value = element_type(fill_value);
+  }
 
-  return tt::Tensor<element_type, extents_type, layout_type>{
-      tt::make_shared<element_type[]>(size, fill_value), extents...};
+  return output_type{data};
 }
 
+} // namespace fixed
 } // namespace operators
 } // namespace tt
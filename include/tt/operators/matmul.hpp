@@ -1,7 +1,21 @@
 #pragma once
 
-#include <tt/operators/dot.hpp>
-#include <tt/operators/empty.hpp>
+#include <tt/core/block_sparse.hpp>
+#include <tt/core/borrow.hpp>
+#include <tt/core/dtype.hpp>
+#include <tt/core/inline_accessor.hpp>
+#include <tt/core/memory.hpp>
+#include <tt/core/sparse.hpp>
+#include <tt/core/tensor.hpp>
+#include <tt/core/tile.hpp>
+#include <tt/operators/full.hpp>
+#include <tt/operators/to_sparse.hpp>
+#include <tt/runtime/layout_cache.hpp>
+#include <tt/runtime/parallel_for.hpp>
+#include <tt/runtime/profiler.hpp>
+
+#include <algorithm>
+#include <utility>
 
 namespace tt {
 inline namespace operators {
@@ -19,6 +33,401 @@ constexpr auto get_extent(const T &t) noexcept {
   }
 }
 
+// rows of lhs, followed by the columns of rhs unless it is a vector
+template <class TLhs, class TRhs>
+constexpr auto product_extents(const TLhs &lhs, const TRhs &rhs) noexcept {
+  const std::size_t rows = lhs.extent(0);
+
+  if constexpr (TRhs::rank() == 1) {
+    return tt::dims<1>{rows};
+  } else {
+    const auto cols = detail::get_extent<1>(rhs);
+
+    return tt::extents_from<std::size_t, decltype(cols)>{rows, cols};
+  }
+}
+
+template <class T>
+struct strided_matrix {
+  T *data;
+  std::size_t rows;
+  std::size_t cols;
+  std::size_t row_stride;
+  std::size_t col_stride;
+
+  constexpr auto operator()(std::size_t row,
+                            std::size_t col) const noexcept -> T & {
+    return data[row * row_stride + col * col_stride];
+  }
+
+  constexpr auto transposed() const noexcept -> strided_matrix {
+    return {data, cols, rows, col_stride, row_stride};
+  }
+};
+
+template <class TInput>
+constexpr auto as_strided_matrix(const TInput &input) noexcept
+    -> strided_matrix<tt::element_type_t<TInput>> {
+  return {
+      tt::borrow(input).data_handle(),
+      input.extent(0),
+      input.extent(1),
+      static_cast<std::size_t>(input.stride(0)),
+      static_cast<std::size_t>(input.stride(1)),
+  };
+}
+
+// chooses the loop order from the operand strides, so that the innermost loop
+// walks contiguous memory whenever some operand combination allows it; result
+// must be zero-initialized
+template <class TLhs, class TRhs, class TResult>
+constexpr auto matmul_strided(const strided_matrix<TLhs> &lhs,
+                              const strided_matrix<TRhs> &rhs,
+                              const strided_matrix<TResult> &result) -> void {
+  using accumulator_type = std::common_type_t<TLhs, TRhs>;
+
+  const auto inner = lhs.cols;
+  const auto grain = tt::grain_size(inner * result.cols);
+
+  if (result.row_stride == 1 and result.col_stride != 1) {
+    // a column-major result is the row-major result of rhs.T @ lhs.T
+    detail::matmul_strided(rhs.transposed(), lhs.transposed(),
+                           result.transposed());
+  } else if (lhs.col_stride == 1 and rhs.row_stride == 1) {
+    // rows of lhs and columns of rhs are both contiguous, e.g. A @ B.T
+    const auto dot_rows = [&](std::size_t first, std::size_t last) {
+      for (auto row = first; row < last; ++row) {
+        const auto lhs_row = &lhs(row, 0);
+
+        for (std::size_t col = 0; col < result.cols; ++col) {
+          const auto rhs_col = &rhs(0, col);
+          accumulator_type value{};
+
+          for (std::size_t index = 0; index < inner; ++index) {
+            value += lhs_row[index] * rhs_col[index];
+          }
+
+          result(row, col) = value;
+        }
+      }
+    };
+
+    tt::parallel_for(0, result.rows, grain, dot_rows);
+  } else {
+    // broadcast each element of lhs across a row of rhs and of result, which
+    // are contiguous for row-major operands
+    const auto broadcast_rows = [&](std::size_t first, std::size_t last) {
+      for (auto row = first; row < last; ++row) {
+        for (std::size_t index = 0; index < inner; ++index) {
+          const auto value = lhs(row, index);
+
+          for (std::size_t col = 0; col < result.cols; ++col) {
+            result(row, col) += value * rhs(index, col);
+          }
+        }
+      }
+    };
+
+    tt::parallel_for(0, result.rows, grain, broadcast_rows);
+  }
+}
+
+// result += lhs * rhs for one face of each operand, all stored row-major with
+// FaceWidth elements per row
+template <std::size_t FaceWidth, class TLhs, class TRhs, class TResult>
+constexpr auto matmul_face(const TLhs *lhs, const TRhs *rhs, TResult *result,
+                           std::size_t rows, std::size_t inner,
+                           std::size_t cols) noexcept -> void {
+  for (std::size_t row = 0; row < rows; ++row) {
+    for (std::size_t index = 0; index < inner; ++index) {
+      const auto value = lhs[row * FaceWidth + index];
+
+      for (std::size_t col = 0; col < cols; ++col) {
+        result[row * FaceWidth + col] += value * rhs[index * FaceWidth + col];
+      }
+    }
+  }
+}
+
+// result_tile += lhs_tile * rhs_tile face by face, skipping the padding of
+// edge tiles
+template <class TLhsTile, class TRhsTile, class TResultTile>
+constexpr auto matmul_tile(const TLhsTile &lhs_tile, const TRhsTile &rhs_tile,
+                           const TResultTile &result_tile) noexcept -> void {
+  using index_type = typename TResultTile::index_type;
+
+  constexpr index_type face_height = TResultTile::face_height;
+  constexpr index_type face_width = TResultTile::face_width;
+
+  for (index_type face_row = 0; face_row * face_height < result_tile.rows;
+       ++face_row) {
+    const auto rows =
+        std::min(face_height, result_tile.rows - face_row * face_height);
+
+    for (index_type face_col = 0; face_col * face_width < result_tile.cols;
+         ++face_col) {
+      const auto cols =
+          std::min(face_width, result_tile.cols - face_col * face_width);
+
+      for (index_type face_inner = 0; face_inner * face_width < lhs_tile.cols;
+           ++face_inner) {
+        const auto inner =
+            std::min(face_width, lhs_tile.cols - face_inner * face_width);
+
+        detail::matmul_face<face_width>(lhs_tile.face(face_row, face_inner),
+                                        rhs_tile.face(face_inner, face_col),
+                                        result_tile.face(face_row, face_col),
+                                        rows, inner, cols);
+      }
+    }
+  }
+}
+
+// streams the tiles of each operand and accumulates them into a
+// zero-initialized result
+template <class TLhs, class TRhs, class TResult>
+constexpr auto matmul_tiles(const TLhs &lhs, const TRhs &rhs,
+                            const TResult &result) -> void {
+  using tile_type = tt::tile_type_t<TResult>;
+  using index_type = typename tile_type::index_type;
+
+  const auto lhs_tiles = tt::tiles(lhs);
+  const auto rhs_tiles = tt::tiles(rhs);
+  const auto inner_tiles = lhs.mapping().tile_cols();
+  const auto col_tiles = rhs.mapping().tile_cols();
+
+  tt::parallel_for_each_tile(result, [&](const auto &result_tile) {
+    const auto tile_row = result_tile.row / tile_type::height;
+    const auto tile_col = result_tile.col / tile_type::width;
+
+    for (index_type tile_inner = 0; tile_inner < inner_tiles; ++tile_inner) {
+      detail::matmul_tile(lhs_tiles[tile_row * inner_tiles + tile_inner],
+                          rhs_tiles[tile_inner * col_tiles + tile_col],
+                          result_tile);
+    }
+  });
+}
+
+// broadcasts each element of a tile of lhs across a row of rhs
+template <class TLhsTile, class TRhs, class TResult>
+constexpr auto matmul_lhs_tile(const TLhsTile &lhs_tile, const TRhs &rhs,
+                               const TResult &result) -> void {
+  using index_type = std::size_t;
+
+  const index_type cols = result.extent(1);
+
+  for (index_type row = 0; row < lhs_tile.rows; ++row) {
+    for (index_type index = 0; index < lhs_tile.cols; ++index) {
+      const auto value = lhs_tile(row, index);
+
+      for (index_type col = 0; col < cols; ++col) {
+        result(lhs_tile.row + row, col) +=
+            value * rhs(lhs_tile.col + index, col);
+      }
+    }
+  }
+}
+
+// walks the tiles of lhs and broadcasts each element across a row of rhs;
+// threads split whole rows of tiles, which write disjoint rows of result
+template <class TLhs, class TRhs, class TResult>
+constexpr auto matmul_lhs_tiles(const TLhs &lhs, const TRhs &rhs,
+                                const TResult &result) -> void {
+  using index_type = std::size_t;
+  using tile_type = tt::tile_type_t<TLhs>;
+
+  const index_type cols = result.extent(1);
+  const auto lhs_tiles = tt::tiles(lhs);
+  const auto tile_cols = lhs.mapping().tile_cols();
+  const auto grain = tt::grain_size(tile_type::height * lhs.extent(1) * cols);
+
+  const auto callback = [&](const auto &lhs_tile) {
+    detail::matmul_lhs_tile(lhs_tile, rhs, result);
+  };
+
+  tt::parallel_for(0, lhs.mapping().tile_rows(), grain,
+                   [&](std::size_t first, std::size_t last) {
+                     lhs_tiles.for_each(first * tile_cols, last * tile_cols,
+                                        callback);
+                   });
+}
+
+// walks the tiles of rhs and accumulates each tile row into a row of result;
+// threads split the rows of result, so every thread walks all of rhs
+template <class TLhs, class TRhs, class TResult>
+constexpr auto matmul_rhs_tiles(const TLhs &lhs, const TRhs &rhs,
+                                const TResult &result) -> void {
+  using index_type = std::size_t;
+
+  const index_type rows = result.extent(0);
+  const auto grain = tt::grain_size(rhs.extent(0) * rhs.extent(1));
+
+  tt::parallel_for(0, rows, grain, [&](std::size_t first, std::size_t last) {
+    tt::for_each_tile(rhs, [&](const auto &rhs_tile) {
+      for (auto row = first; row < last; ++row) {
+        for (index_type index = 0; index < rhs_tile.rows; ++index) {
+          const auto value = lhs(row, rhs_tile.row + index);
+
+          for (index_type col = 0; col < rhs_tile.cols; ++col) {
+            result(row, rhs_tile.col + col) += value * rhs_tile(index, col);
+          }
+        }
+      }
+    });
+  });
+}
+
+// visits only the stored tiles of lhs; threads split its rows of tiles, which
+// write disjoint rows of result. A result tiled like lhs accumulates tile by
+// tile from the matching tiles of rhs
+template <class TLhs, class TRhs, class TResult>
+auto matmul_block_sparse(const TLhs &lhs, const TRhs &rhs,
+                         const TResult &result) -> void {
+  using index_type = std::size_t;
+  using tile_type = typename TLhs::tile_type;
+
+  const index_type tile_rows = lhs.tile_rows();
+  // stored tiles in an average row of tiles
+  const auto row_tiles = std::max<index_type>(
+      lhs.stored_tiles() / std::max<index_type>(tile_rows, 1), 1);
+  const auto grain =
+      tt::grain_size(row_tiles * tile_type::size() * result.extent(1));
+
+  const auto for_each_tile = [&](const auto &callback) {
+    tt::parallel_for(0, tile_rows, grain,
+                     [&](std::size_t first, std::size_t last) {
+                       for (auto tile_row = first; tile_row < last;
+                            ++tile_row) {
+                         lhs.for_each_tile(tile_row, callback);
+                       }
+                     });
+  };
+
+  if constexpr (tt::tiled<TResult>) {
+    const auto rhs_tiles = tt::tiles(rhs);
+    const auto result_tiles = tt::tiles(result);
+    const auto col_tiles = result.mapping().tile_cols();
+
+    for_each_tile([&](const auto &lhs_tile) {
+      const auto tile_row = lhs_tile.row / tile_type::height;
+      const auto tile_inner = lhs_tile.col / tile_type::width;
+
+      for (index_type tile_col = 0; tile_col < col_tiles; ++tile_col) {
+        detail::matmul_tile(lhs_tile,
+                            rhs_tiles[tile_inner * col_tiles + tile_col],
+                            result_tiles[tile_row * col_tiles + tile_col]);
+      }
+    });
+  } else {
+    for_each_tile([&](const auto &lhs_tile) {
+      detail::matmul_lhs_tile(lhs_tile, rhs, result);
+    });
+  }
+}
+
+// result(row, :) = sum of value * rhs(column, :) over the stored elements of
+// each row of lhs, on ranges of rows balanced by their stored elements; result
+// must be zero-initialized
+template <class T, class TRhs, class TResult>
+auto matmul_csr(const tt::csr_matrix<T> &lhs, const TRhs &rhs,
+                const TResult &result) -> void {
+  using accumulator_type = std::common_type_t<T, tt::element_type_t<TRhs>>;
+  using index_type = std::size_t;
+
+  const auto row_offsets = lhs.row_offsets().get();
+  const auto columns = lhs.columns().get();
+  const auto values = lhs.values().get();
+
+  if constexpr (TRhs::rank() == 1) {
+    tt::parallel_for_rows(lhs, 1, [&](std::size_t first, std::size_t last) {
+      for (auto row = first; row < last; ++row) {
+        accumulator_type value{};
+
+        for (auto index = row_offsets[row]; index < row_offsets[row + 1];
+             ++index) {
+          value += values[index] * rhs(columns[index]);
+        }
+
+        result(row) = value;
+      }
+    });
+  } else {
+    const index_type cols = result.extent(1);
+
+    tt::parallel_for_rows(lhs, cols, [&](std::size_t first, std::size_t last) {
+      for (auto row = first; row < last; ++row) {
+        for (auto index = row_offsets[row]; index < row_offsets[row + 1];
+             ++index) {
+          const auto value = values[index];
+          const auto inner = columns[index];
+
+          for (index_type col = 0; col < cols; ++col) {
+            result(row, col) += value * rhs(inner, col);
+          }
+        }
+      }
+    });
+  }
+}
+
+// one element of the product of fixed-size operands, unrolled over their
+// inner extent
+template <class TAccumulator, class TLhs, class TRhs, std::size_t... Inner>
+constexpr auto matmul_element(const TLhs &lhs, const TRhs &rhs,
+                              std::size_t row, std::size_t col,
+                              std::index_sequence<Inner...>) noexcept
+    -> TAccumulator {
+  return (TAccumulator{} + ... + (lhs(row, Inner) * rhs(Inner, col)));
+}
+
+// product of operands that hold their elements by value, into a result that
+// does too; every extent is static, so there is nothing to allocate, schedule
+// or profile and the compiler sees every trip count
+template <class TElement, class TLayout, class TLhs, class TRhs>
+constexpr auto matmul_fixed(const TLhs &lhs, const TRhs &rhs) noexcept {
+  using accumulator_type = tt::common_element_type_t<TLhs, TRhs>;
+  using extents_type = std::extents<std::size_t, TLhs::static_extent(0),
+                                    TRhs::static_extent(1)>;
+  using output_type = tt::InlineTensor<TElement, extents_type, TLayout>;
+
+  typename output_type::data_handle_type data{};
+  const typename output_type::mapping_type mapping{};
+
+  for (std::size_t row = 0; row < extents_type::static_extent(0); ++row) {
+    for (std::size_t col = 0; col < extents_type::static_extent(1); ++col) {
+      data.values[mapping(row, col)] = detail::matmul_element<accumulator_type>(
+          lhs, rhs, row, col,
+          std::make_index_sequence<TLhs::static_extent(1)>{});
+    }
+  }
+
+  return output_type{data};
+}
+
+// fallback for layouts that are neither strided nor tiled
+template <class TLhs, class TRhs, class TResult>
+constexpr auto matmul_elements(const TLhs &lhs, const TRhs &rhs,
+                               const TResult &result) -> void {
+  using index_type = std::size_t;
+
+  const index_type rows = result.extent(0);
+  const index_type cols = result.extent(1);
+  const index_type inner = lhs.extent(1);
+  const auto grain = tt::grain_size(inner * cols);
+
+  tt::parallel_for(0, rows, grain, [&](std::size_t first, std::size_t last) {
+    for (auto row = first; row < last; ++row) {
+      for (index_type index = 0; index < inner; ++index) {
+        const auto value = lhs(row, index);
+
+        for (index_type col = 0; col < cols; ++col) {
+          result(row, col) += value * rhs(index, col);
+        }
+      }
+    }
+  });
+}
+
 } // namespace
 } // namespace detail
 
@@ -32,6 +441,70 @@ inline constexpr bool has_matrix_product<
                      tt::common_extent_with<TLhs::static_extent(1),
                                             TRhs::static_extent(0)>>> = true;
 
+// both operands share a tiled layout whose tiles and faces are square, so the
+// inner tiles and faces of lhs line up with those of rhs
+template <class TLhs, class TRhs, class = void>
+inline constexpr bool has_tiled_matrix_product = false;
+
+template <class TLhs, class TRhs>
+inline constexpr bool has_tiled_matrix_product<
+    TLhs, TRhs,
+    std::enable_if_t<
+        tt::tiled<TLhs> and
+        std::is_same_v<tt::layout_type_t<TLhs>, tt::layout_type_t<TRhs>> and
+        tt::layout_type_t<TLhs>::tile_height ==
+            tt::layout_type_t<TLhs>::tile_width and
+        tt::layout_type_t<TLhs>::face_height ==
+            tt::layout_type_t<TLhs>::face_width>> = true;
+
+// layout of the result of matmul: tiled operands keep their layout and two
+// column-major operands produce a column-major result, so that no kernel needs
+// to write across the grain of its operands
+template <class TLhs, class TRhs>
+using matmul_layout_t = std::conditional_t<
+    tt::has_tiled_matrix_product<TLhs, TRhs> or
+        (std::is_same_v<tt::layout_type_t<TLhs>, tt::ColMajor> and
+         std::is_same_v<tt::layout_type_t<TRhs>, tt::ColMajor>),
+    tt::layout_type_t<TLhs>, tt::RowMajor>;
+
+namespace detail {
+namespace {
+
+// result += lhs * rhs with the kernel that suits the layouts of the operands,
+// into a result in the layout tt::matmul_layout_t gives them
+template <class TLhs, class TRhs, class TResult>
+auto matmul_dense(const TLhs &lhs, const TRhs &rhs, const TResult &result)
+    -> void {
+  const auto lhs_view = tt::borrow(lhs);
+  const auto rhs_view = tt::borrow(rhs);
+  const auto result_view = tt::borrow(result);
+
+  // the tiled and strided kernels read through pointers, which generated
+  // operands do not have
+  constexpr bool lhs_addressable = not tt::generated<TLhs>;
+  constexpr bool rhs_addressable = not tt::generated<TRhs>;
+
+  if constexpr (tt::has_tiled_matrix_product<TLhs, TRhs> and
+                lhs_addressable and rhs_addressable) {
+    detail::matmul_tiles(lhs_view, rhs_view, result_view);
+  } else if constexpr (tt::tiled<TLhs> and lhs_addressable) {
+    detail::matmul_lhs_tiles(lhs_view, rhs_view, result_view);
+  } else if constexpr (tt::tiled<TRhs> and rhs_addressable) {
+    detail::matmul_rhs_tiles(lhs_view, rhs_view, result_view);
+  } else if constexpr (TLhs::is_always_strided() and
+                       TRhs::is_always_strided() and lhs_addressable and
+                       rhs_addressable) {
+    detail::matmul_strided(detail::as_strided_matrix(lhs_view),
+                           detail::as_strided_matrix(rhs_view),
+                           detail::as_strided_matrix(result_view));
+  } else {
+    detail::matmul_elements(lhs_view, rhs_view, result_view);
+  }
+}
+
+} // namespace
+} // namespace detail
+
 template <auto... Vs, class TLhs, class TRhs,
           class = std::enable_if_t<tt::has_matrix_product<TLhs, TRhs>>>
 constexpr auto matmul(const TLhs &lhs, const TRhs &rhs) {
@@ -40,24 +513,133 @@ constexpr auto matmul(const TLhs &lhs, const TRhs &rhs) {
   constexpr auto common_dtype =
       tt::value_v<tt::dtypes, tt::common_element_type_t<TLhs, TRhs>>;
   using element_type = tt::type_t<tt::dtypes, common_dtype, Vs...>;
-  constexpr auto dtype = tt::value_v<tt::dtypes, element_type>;
 
   const auto rows = detail::get_extent<0>(lhs);
   const auto cols = detail::get_extent<1>(rhs);
-  const auto result = tt::empty<dtype>(rows, cols);
 
-  for (std::size_t col = 0; col < cols; ++col) {
-    const auto rhs_col = std::submdspan(rhs, std::full_extent, col);
+  using extents_type = tt::extents_from<decltype(rows), decltype(cols)>;
+  using layout_type = tt::matmul_layout_t<TLhs, TRhs>;
+  using mapping_type = typename layout_type::template mapping<extents_type>;
 
-    for (std::size_t row = 0; row < rows; ++row) {
-      const auto lhs_row = std::submdspan(lhs, row, std::full_extent);
+  if constexpr (tt::fixed_size<TLhs> and tt::fixed_size<TRhs>) {
+    return detail::matmul_fixed<element_type, layout_type>(lhs, rhs);
+  } else {
+    using output_type = tt::Tensor<element_type, extents_type, layout_type>;
 
-      result(row, col) = tt::dot(lhs_row, rhs_col);
-    }
+    tt::profile_scope scope{"matmul", lhs, rhs};
+    const mapping_type mapping{extents_type{rows, cols}};
+    const output_type result{tt::make_shared<element_type[]>(mapping), mapping};
+
+    detail::matmul_dense(lhs, rhs, result);
+
+    scope.output(result);
+
+    return result;
   }
+}
+
+// writes the product into result instead of a new buffer; result has the
+// extents, element type and layout tt::matmul would give it, and must not
+// share elements with the operands
+template <class TResult, class TLhs, class TRhs,
+          class = std::enable_if_t<
+              tt::has_matrix_product<TLhs, TRhs> and tt::matrix<TResult> and
+              tt::writable<TResult> and
+              std::is_same_v<tt::layout_type_t<TResult>,
+                             tt::matmul_layout_t<TLhs, TRhs>>>>
+auto matmul_out(const TResult &result, const TLhs &lhs, const TRhs &rhs)
+    -> TResult {
+  assert(lhs.extent(1) == rhs.extent(0));
+  assert(result.extent(0) == lhs.extent(0) and
+         result.extent(1) == rhs.extent(1));
+  assert(not tt::runtime::detail::overlaps(result, lhs) and
+         not tt::runtime::detail::overlaps(result, rhs));
+
+  using element_type = tt::element_type_t<TResult>;
+
+  tt::profile_scope scope{"matmul", lhs, rhs};
+
+  // the kernels accumulate into the result
+  detail::fill_span(result, element_type{});
+  detail::matmul_dense(lhs, rhs, result);
+  tt::get_layout_cache().invalidate(result);
+  scope.output(result);
 
   return result;
 }
 
+// skips the tiles of lhs that are not stored, so that the work shrinks with
+// its density; rhs in the same square tiled layout keeps it, and any other rhs
+// gives a row-major result
+template <auto... Vs, class T, class TLayout, class TRhs,
+          class = std::enable_if_t<tt::matrix<TRhs>>>
+auto matmul(const tt::block_sparse_matrix<T, TLayout> &lhs, const TRhs &rhs) {
+  using lhs_type = tt::block_sparse_matrix<T, TLayout>;
+
+  assert(lhs.extent(1) == rhs.extent(0));
+
+  constexpr auto common_dtype =
+      tt::value_v<tt::dtypes, tt::common_element_type_t<lhs_type, TRhs>>;
+  using element_type = tt::type_t<tt::dtypes, common_dtype, Vs...>;
+
+  constexpr bool tiled_product =
+      std::is_same_v<TLayout, tt::layout_type_t<TRhs>> and
+      TLayout::tile_height == TLayout::tile_width and
+      TLayout::face_height == TLayout::face_width and not tt::generated<TRhs>;
+
+  const std::size_t rows = lhs.extent(0);
+  const auto cols = detail::get_extent<1>(rhs);
+
+  using extents_type = tt::extents_from<std::size_t, decltype(cols)>;
+  using layout_type = std::conditional_t<tiled_product, TLayout, tt::RowMajor>;
+  using mapping_type = typename layout_type::template mapping<extents_type>;
+  using output_type = tt::Tensor<element_type, extents_type, layout_type>;
+
+  tt::profile_scope scope{"matmul", rhs};
+  const mapping_type mapping{extents_type{rows, cols}};
+  const output_type result{tt::make_shared<element_type[]>(mapping), mapping};
+
+  detail::matmul_block_sparse(lhs, tt::borrow(rhs), tt::borrow(result));
+
+  scope.output(result);
+
+  return result;
+}
+
+// sparse-dense products, whose work is proportional to the stored elements of
+// lhs; a vector rhs gives a vector and a matrix rhs gives a row-major matrix
+template <auto... Vs, class T, class TRhs,
+          class = std::enable_if_t<tt::matrix<TRhs> or tt::vector<TRhs>>>
+auto matmul(const tt::csr_matrix<T> &lhs, const TRhs &rhs) {
+  assert(lhs.extent(1) == rhs.extent(0));
+
+  constexpr auto common_dtype =
+      tt::value_v<tt::dtypes,
+                  tt::common_element_type_t<tt::csr_matrix<T>, TRhs>>;
+  using element_type = tt::type_t<tt::dtypes, common_dtype, Vs...>;
+
+  const auto extents = detail::product_extents(lhs, rhs);
+
+  using extents_type = std::remove_const_t<decltype(extents)>;
+  using mapping_type = tt::RowMajor::mapping<extents_type>;
+  using output_type = tt::Tensor<element_type, extents_type, tt::RowMajor>;
+
+  tt::profile_scope scope{"matmul", rhs};
+  const mapping_type mapping{extents};
+  const output_type result{tt::make_shared<element_type[]>(mapping), mapping};
+
+  detail::matmul_csr(lhs, tt::borrow(rhs), tt::borrow(result));
+
+  scope.output(result);
+
+  return result;
+}
+
+template <auto... Vs, class T, class TRhs,
+          class = std::enable_if_t<tt::matrix<TRhs> or tt::vector<TRhs>>>
+auto matmul(const tt::coo_matrix<T> &lhs, const TRhs &rhs) {
+  return tt::matmul<Vs...>(lhs | tt::to_csr_view{}, rhs);
+}
+
 } // namespace operators
 } // namespace tt
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <tt/core/borrow.hpp>
+#include <tt/core/mapped_file.hpp>
+#include <tt/core/tensor.hpp>
+#include <tt/core/tile.hpp>
+#include <tt/operators/matmul.hpp>
+#include <tt/runtime/layout_cache.hpp>
+#include <tt/runtime/parallel_for.hpp>
+#include <tt/runtime/profiler.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+namespace tt {
+inline namespace operators {
+
+// Writes lhs @ rhs into result like tt::matmul_out, for operands too large
+// for memory such as files mapped by tt::map_file and tt::create_file. Panels
+// of whole rows of tiles of lhs stay in memory while rhs streams past them a
+// block of rows of tiles at a time, so lhs and result are read once and rhs
+// once per panel, always in storage order. A quarter of memory_budget bytes
+// goes to the blocks of rhs and the rest to the panels, as large as it allows.
+// The next panel of lhs and the next block of rhs are prefetched while the
+// current ones are multiplied, so that reading them overlaps the work.
+template <class TResult, class TLhs, class TRhs,
+          class = std::enable_if_t<
+              tt::has_tiled_matrix_product<TLhs, TRhs> and
+              tt::matrix<TResult> and tt::writable<TResult> and
+              std::is_same_v<tt::layout_type_t<TResult>,
+                             tt::layout_type_t<TLhs>> and
+              not tt::generated<TLhs> and not tt::generated<TRhs>>>
+auto matmul_out_of_core(const TResult &result, const TLhs &lhs,
+                        const TRhs &rhs, std::size_t memory_budget)
+    -> TResult {
+  assert(lhs.extent(1) == rhs.extent(0));
+  assert(result.extent(0) == lhs.extent(0) and
+         result.extent(1) == rhs.extent(1));
+  assert(not tt::runtime::detail::overlaps(result, lhs) and
+         not tt::runtime::detail::overlaps(result, rhs));
+
+  using result_element_type = tt::element_type_t<TResult>;
+  using tile_type = tt::tile_type_t<TResult>;
+
+  constexpr auto tile_size = tile_type::size();
+
+  tt::profile_scope scope{"matmul_out_of_core", lhs, rhs};
+  const auto lhs_view = tt::borrow(lhs);
+  const auto rhs_view = tt::borrow(rhs);
+  const auto result_view = tt::borrow(result);
+  const std::size_t row_tiles = lhs.mapping().tile_rows();
+  const std::size_t inner_tiles = lhs.mapping().tile_cols();
+  const std::size_t col_tiles = rhs.mapping().tile_cols();
+
+  // bytes of a row of tiles of each operand
+  const auto lhs_row_bytes =
+      inner_tiles * tile_size * sizeof(tt::element_type_t<TLhs>);
+  const auto rhs_row_bytes =
+      col_tiles * tile_size * sizeof(tt::element_type_t<TRhs>);
+  const auto result_row_bytes =
+      col_tiles * tile_size * sizeof(result_element_type);
+
+  // the block of rhs multiplied and the one prefetched
+  const auto block_rows = std::clamp<std::size_t>(
+      memory_budget / 4 / std::max<std::size_t>(2 * rhs_row_bytes, 1), 1,
+      std::max<std::size_t>(inner_tiles, 1));
+  const auto block_bytes = 2 * block_rows * rhs_row_bytes;
+  // the panel of lhs multiplied and the one prefetched, and the panel of
+  // result they accumulate into
+  const auto panel_rows = std::clamp<std::size_t>(
+      memory_budget > block_bytes
+          ? (memory_budget - block_bytes) /
+                std::max<std::size_t>(2 * lhs_row_bytes + result_row_bytes, 1)
+          : 0,
+      1, std::max<std::size_t>(row_tiles, 1));
+
+  // the tile in tile row and tile column of a matrix, located without the
+  // divisions of tt::tiles()[index], which would outweigh small tiles
+  const auto tile_at = [](const auto &input, std::size_t tile_row,
+                          std::size_t tile_col) {
+    using input_tile_type = tt::tile_type_t<std::decay_t<decltype(input)>>;
+
+    const std::size_t tile_cols = input.mapping().tile_cols();
+    const auto row = tile_row * tile_type::height;
+    const auto col = tile_col * tile_type::width;
+
+    return input_tile_type{
+        input.data_handle() + (tile_row * tile_cols + tile_col) * tile_size,
+        {},
+        row,
+        col,
+        std::min<std::size_t>(tile_type::height, input.extent(0) - row),
+        std::min<std::size_t>(tile_type::width, input.extent(1) - col),
+    };
+  };
+
+  const auto prefetch_lhs = [&](std::size_t first, std::size_t last) {
+    if (first < last) {
+      tt::prefetch(lhs_view.data_handle() + first * inner_tiles * tile_size,
+                   (last - first) * inner_tiles * tile_size);
+    }
+  };
+
+  const auto prefetch_rhs = [&](std::size_t first, std::size_t last) {
+    if (first < last) {
+      tt::prefetch(rhs_view.data_handle() + first * col_tiles * tile_size,
+                   (last - first) * col_tiles * tile_size);
+    }
+  };
+
+  prefetch_lhs(0, std::min(panel_rows, row_tiles));
+
+  for (std::size_t first = 0; first < row_tiles; first += panel_rows) {
+    const auto last = std::min(first + panel_rows, row_tiles);
+    const auto panel_tiles = (last - first) * col_tiles;
+
+    prefetch_lhs(last, std::min(last + panel_rows, row_tiles));
+    prefetch_rhs(0, std::min(block_rows, inner_tiles));
+
+    // the panel of result accumulates over the blocks of rhs
+    if (panel_tiles > 0) {
+      const auto panel =
+          result_view.data_handle() + first * col_tiles * tile_size;
+
+      tt::parallel_for(
+          0, panel_tiles * tile_size, tt::default_grain_size,
+          [&](std::size_t begin, std::size_t end) {
+            std::fill(panel + begin, panel + end, result_element_type{});
+          });
+    }
+
+    for (std::size_t block = 0; block < inner_tiles; block += block_rows) {
+      const auto block_end = std::min(block + block_rows, inner_tiles);
+
+      prefetch_rhs(block_end, std::min(block_end + block_rows, inner_tiles));
+
+      // threads split the tiles of the panel, which are disjoint
+      tt::parallel_for(
+          0, panel_tiles,
+          tt::grain_size((block_end - block) * tile_size * tile_type::width),
+          [&](std::size_t begin, std::size_t end) {
+            for (auto index = begin; index < end; ++index) {
+              const auto tile_row = first + index / col_tiles;
+              const auto tile_col = index % col_tiles;
+              const auto result_tile =
+                  tile_at(result_view, tile_row, tile_col);
+
+              for (auto tile_inner = block; tile_inner < block_end;
+                   ++tile_inner) {
+                detail::matmul_tile(tile_at(lhs_view, tile_row, tile_inner),
+                                    tile_at(rhs_view, tile_inner, tile_col),
+                                    result_tile);
+              }
+            }
+          });
+    }
+  }
+
+  tt::get_layout_cache().invalidate(result);
+  scope.output(result);
+
+  return result;
+}
+
+} // namespace operators
+} // namespace tt
@@ -10,5 +10,18 @@ constexpr auto ones(TIndices... extents) {
   return tt::full<Vs...>(1.f, extents...);
 }
 
+template <class TOutput, class = std::enable_if_t<tt::writable<TOutput>>>
+auto ones_out(const TOutput &output) -> TOutput {
+  return tt::full_out(output, 1.f);
+}
+
+namespace fixed {
+
+template <auto... Vs, class... TIndices>
+constexpr auto ones(TIndices... extents) noexcept {
+  return fixed::full<Vs...>(1.f, extents...);
+}
+
+} // namespace fixed
 } // namespace operators
 } // namespace tt
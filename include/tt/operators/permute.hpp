@@ -0,0 +1,67 @@
+#pragma once
+
+#include <tt/core/concepts.hpp>
+#include <tt/core/layout.hpp>
+
+#include <array>
+#include <cassert>
+#include <utility>
+
+namespace tt {
+inline namespace operators {
+
+template <std::size_t Rank>
+struct permute_view {
+private:
+  std::array<std::size_t, Rank> axes;
+
+public:
+  constexpr permute_view() noexcept = default;
+  constexpr permute_view(const std::array<std::size_t, Rank> &axes)
+      : axes{axes} {}
+
+  // returns a strided view of the input's buffer whose r-th extent is extent
+  // axes[r] of the input
+  template <class TInput,
+            class = std::enable_if_t<tt::tensor<TInput> and
+                                     tt::has_rank<TInput, Rank> and
+                                     TInput::is_always_strided()>>
+  friend constexpr auto operator|(const TInput &input,
+                                  const permute_view &view) {
+    using element_type = tt::element_type_t<TInput>;
+    using extents_type = tt::dims<Rank>;
+    using mapping_type = tt::Strided::mapping<extents_type>;
+    using accessor_type = tt::accessor_type_t<TInput>;
+    using output_type = std::mdspan<element_type, extents_type, tt::Strided,
+                                    accessor_type>;
+    using index_type = tt::index_type_t<extents_type>;
+
+    std::array<index_type, Rank> extents{};
+    std::array<index_type, Rank> strides{};
+    [[maybe_unused]] std::array<bool, Rank> seen{};
+
+    for (std::size_t r = 0; r < Rank; ++r) {
+      const auto axis = view.axes[r];
+
+      assert(axis < Rank and not std::exchange(seen[axis], true));
+
+      extents[r] = input.extent(axis);
+      strides[r] = input.stride(axis);
+    }
+
+    return output_type{input.data_handle(),
+                       mapping_type{extents_type{extents}, strides},
+                       input.accessor()};
+  }
+};
+
+template <class... TIndices,
+          class = std::enable_if_t<(... and tt::index<TIndices>)>>
+constexpr auto permute(TIndices... axes)
+    -> tt::permute_view<sizeof...(TIndices)> {
+  return std::array<std::size_t, sizeof...(TIndices)>{
+      static_cast<std::size_t>(axes)...};
+}
+
+} // namespace operators
+} // namespace tt
@@ -18,7 +18,12 @@ public:
   constexpr reshape_view() noexcept = default;
   constexpr reshape_view(const TExtents &extents) : extents{extents} {}
 
-  template <class TInput, class = std::enable_if_t<tt::tensor<TInput>>>
+  // strided views such as permuted tensors carry no mapping for new extents
+  template <class TInput,
+            class = std::enable_if_t<
+                tt::tensor<TInput> and
+                std::is_constructible_v<tt::mapping_type_t<TInput, TExtents>,
+                                        const TExtents &>>>
   friend constexpr auto operator|(const TInput &input,
                                   const reshape_view &view) {
     using element_type = tt::element_type_t<TInput>;
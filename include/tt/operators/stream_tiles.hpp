@@ -0,0 +1,217 @@
+#pragma once
+
+#include <tt/core/borrow.hpp>
+#include <tt/core/layout.hpp>
+#include <tt/core/memory.hpp>
+#include <tt/core/tensor.hpp>
+#include <tt/core/tile.hpp>
+#include <tt/operators/to_layout.hpp>
+#include <tt/runtime/bounded_queue.hpp>
+#include <tt/runtime/parallel_for.hpp>
+#include <tt/runtime/profiler.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace tt {
+inline namespace operators {
+
+// bytes of the tiles in flight between the producer and the consumers of a
+// stream, which keeps them within a typical L2 cache
+inline constexpr std::size_t default_stream_bytes = std::size_t{1} << 18;
+
+namespace detail {
+namespace {
+
+// copies the elements of the input under a tile into the tile, zeroing the
+// padding of tiles at the edges
+template <class TTile, class TInput>
+auto fill_tile(const TTile &tile, const TInput &input) -> void {
+  using element_type = typename TTile::element_type;
+  using index_type = typename TTile::index_type;
+
+  constexpr auto input_width =
+      detail::contiguous_width<tt::layout_type_t<TInput>>();
+
+  if (tile.rows < TTile::height or tile.cols < TTile::width) {
+    std::fill(tile.begin(), tile.end(), element_type{});
+  }
+
+  detail::for_each_run<input_width>(
+      tile, [&](index_type row, index_type col, index_type width) {
+        if constexpr (tt::generated<TInput>) {
+          for (index_type offset = 0; offset < width; ++offset) {
+            tile(row, col + offset) = tile.at(input, row, col + offset);
+          }
+        } else {
+          std::copy_n(&tile.at(input, row, col), width, &tile(row, col));
+        }
+      });
+}
+
+} // namespace
+} // namespace detail
+
+// Hands the tiles of input | tt::to_layout<TLayout>() to consumer one at a
+// time instead of materializing the tiled tensor: a producer thread copies
+// batches of consecutive tiles into staging buffers for about capacity tiles,
+// which wait in a bounded queue until a consumer on the thread pool takes them
+// and are reused once it returns, so the tiles in flight stay in cache. Tiles
+// arrive in no particular order and consumers run concurrently, so each should
+// write outputs of its own tile, e.g. the tile of another tensor at the same
+// coordinates. The tile and its staging buffer are only valid during the call.
+template <class TLayout, class TInput, class TConsumer,
+          class = std::enable_if_t<tt::tensor<TInput> and
+                                   tt::is_tiled_layout_v<TLayout> and
+                                   TInput::rank() >= 2>>
+auto stream_tiles(const TInput &input, const TConsumer &consumer,
+                  std::size_t capacity) -> void {
+  using element_type = tt::element_type_t<TInput>;
+  using extents_type = tt::extents_type_t<TInput>;
+  using mapping_type = typename TLayout::template mapping<extents_type>;
+  using tile_type = tt::tile<element_type, TLayout, TInput::rank() - 2>;
+  using batch_type = typename tile_type::batch_type;
+  using index_type = typename tile_type::index_type;
+
+  constexpr auto rank = TInput::rank();
+  constexpr auto tile_size = TLayout::tile_size;
+
+  tt::profile_scope scope{"stream_tiles", input};
+  const mapping_type mapping{input.extents()};
+  const auto input_view = tt::borrow(input);
+  const index_type rows = input.extent(rank - 2);
+  const index_type cols = input.extent(rank - 1);
+  const index_type tile_rows = mapping.tile_rows();
+  const index_type tile_cols = mapping.tile_cols();
+  const auto tiles_per_matrix = tile_rows * tile_cols;
+  index_type count = tiles_per_matrix;
+
+  for (std::size_t r = 0; r + 2 < rank; ++r) {
+    count *= input.extent(r);
+  }
+
+  if (count == 0) {
+    return;
+  }
+
+  // the tile at index in the storage order of TLayout, staged at data
+  const auto tile_at = [&](index_type index, element_type *data) {
+    const auto tile_index = index % tiles_per_matrix;
+    const auto row = tile_index / tile_cols * tile_type::height;
+    const auto col = tile_index % tile_cols * tile_type::width;
+
+    batch_type batch{};
+
+    for (auto matrix = index / tiles_per_matrix, r = batch.size(); r-- > 0;) {
+      batch[r] = matrix % input.extent(r);
+      matrix /= input.extent(r);
+    }
+
+    return tile_type{
+        data,
+        batch,
+        row,
+        col,
+        std::min(tile_type::height, rows - row),
+        std::min(tile_type::width, cols - col),
+    };
+  };
+
+  // tiles handed over at once, enough to amortize the queues, with at least
+  // two batches in flight so that the producer fills one while another is
+  // consumed
+  capacity = std::clamp<std::size_t>(capacity, 1, count);
+  const auto batch_size =
+      std::clamp<std::size_t>(tt::grain_size(tile_size), 1,
+                              std::max<std::size_t>(capacity / 2, 1));
+  const auto slots = std::max<std::size_t>(capacity / batch_size, 1);
+  const auto slot_size = batch_size * tile_size;
+
+  const auto staging =
+      tt::make_shared_for_overwrite<element_type[]>(slots * slot_size);
+  // staging buffers free to fill, and filled ones with their first tile
+  tt::bounded_queue<std::size_t> free_slots{slots};
+  tt::bounded_queue<std::pair<index_type, std::size_t>> ready{slots};
+
+  for (std::size_t slot = 0; slot < slots; ++slot) {
+    free_slots.push(slot);
+  }
+
+  // a thread of its own rather than a task of the pool, whose threads may
+  // all be consumers waiting on it
+  std::thread producer{[&] {
+    for (index_type first = 0; first < count; first += batch_size) {
+      const auto slot = free_slots.pop();
+
+      if (not slot) {
+        break;
+      }
+
+      const auto last = std::min<index_type>(first + batch_size, count);
+      auto data = staging.get() + *slot * slot_size;
+
+      for (auto index = first; index < last; ++index, data += tile_size) {
+        detail::fill_tile(tile_at(index, data), input_view);
+      }
+
+      if (not ready.push({first, *slot})) {
+        break;
+      }
+    }
+
+    ready.close();
+  }};
+
+  const auto consume = [&](std::size_t, std::size_t) {
+    try {
+      while (const auto item = ready.pop()) {
+        const auto [first, slot] = *item;
+        const auto last = std::min<index_type>(first + batch_size, count);
+        auto data = staging.get() + slot * slot_size;
+
+        for (auto index = first; index < last; ++index, data += tile_size) {
+          consumer(tile_at(index, data));
+        }
+
+        free_slots.push(slot);
+      }
+    } catch (...) {
+      // stops the producer and the other consumers
+      free_slots.close();
+      ready.close();
+      throw;
+    }
+  };
+
+  try {
+    tt::parallel_for(0, tt::get_num_threads(), 1, consume);
+  } catch (...) {
+    producer.join();
+    throw;
+  }
+
+  producer.join();
+}
+
+// stages as many tiles as fit in tt::default_stream_bytes, and at least two
+// batches per thread so that no consumer waits while another holds one
+template <class TLayout, class TInput, class TConsumer,
+          class = std::enable_if_t<tt::tensor<TInput> and
+                                   tt::is_tiled_layout_v<TLayout> and
+                                   TInput::rank() >= 2>>
+auto stream_tiles(const TInput &input, const TConsumer &consumer) -> void {
+  using element_type = tt::element_type_t<TInput>;
+
+  constexpr auto tile_size = TLayout::tile_size;
+  constexpr auto tile_bytes = tile_size * sizeof(element_type);
+
+  tt::stream_tiles<TLayout>(
+      input, consumer,
+      std::max(tt::default_stream_bytes / tile_bytes,
+               2 * tt::get_num_threads() * tt::grain_size(tile_size)));
+}
+
+} // namespace operators
+} // namespace tt
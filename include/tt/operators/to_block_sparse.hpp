@@ -0,0 +1,125 @@
+#pragma once
+
+#include <tt/core/block_sparse.hpp>
+#include <tt/core/borrow.hpp>
+#include <tt/core/memory.hpp>
+#include <tt/core/tensor.hpp>
+#include <tt/core/tile.hpp>
+#include <tt/operators/to_layout.hpp>
+#include <tt/runtime/parallel_for.hpp>
+#include <tt/runtime/profiler.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+namespace tt {
+inline namespace operators {
+
+struct to_block_sparse_view {};
+
+// keeps the tiles of a tiled matrix that hold a non-zero element, padding
+// included
+template <class TInput,
+          class = std::enable_if_t<tt::tiled<TInput> and tt::matrix<TInput> and
+                                   not tt::generated<TInput>>>
+auto operator|(const TInput &input, const tt::to_block_sparse_view &) {
+  using element_type = tt::element_type_t<TInput>;
+  using layout_type = tt::layout_type_t<TInput>;
+  using output_type = tt::block_sparse_matrix<element_type, layout_type>;
+  using index_type = typename output_type::index_type;
+  using tile_type = typename output_type::tile_type;
+
+  tt::profile_scope scope{"to_block_sparse", input};
+  const auto range = tt::tiles(input);
+  const index_type tile_rows = input.mapping().tile_rows();
+  const index_type tile_cols = input.mapping().tile_cols();
+  const auto grain = tt::grain_size(tile_cols * tile_type::size());
+  const auto is_stored = [](const tile_type &tile) {
+    return std::any_of(tile.begin(), tile.end(),
+                       [](const element_type &value) {
+                         return value != element_type{};
+                       });
+  };
+
+  // stored tiles per row of tiles, after the leading zero of the offsets
+  const auto row_offsets = tt::make_shared<index_type[]>(tile_rows + 1);
+
+  tt::parallel_for(
+      0, tile_rows, grain, [&](std::size_t first, std::size_t last) {
+        for (auto tile_row = first; tile_row < last; ++tile_row) {
+          range.for_each(tile_row * tile_cols, (tile_row + 1) * tile_cols,
+                         [&](const tile_type &tile) {
+                           row_offsets[tile_row + 1] += is_stored(tile);
+                         });
+        }
+      });
+
+  std::partial_sum(row_offsets.get(), row_offsets.get() + tile_rows + 1,
+                   row_offsets.get());
+
+  const auto stored_tiles = row_offsets[tile_rows];
+  const auto columns =
+      tt::make_shared_for_overwrite<index_type[]>(stored_tiles);
+  const auto data = tt::make_shared_for_overwrite<element_type[]>(
+      stored_tiles * tile_type::size());
+
+  tt::parallel_for(
+      0, tile_rows, grain, [&](std::size_t first, std::size_t last) {
+        for (auto tile_row = first; tile_row < last; ++tile_row) {
+          auto index = row_offsets[tile_row];
+
+          range.for_each(
+              tile_row * tile_cols, (tile_row + 1) * tile_cols,
+              [&](const tile_type &tile) {
+                if (is_stored(tile)) {
+                  columns[index] = tile.col / tile_type::width;
+                  std::copy_n(tile.begin(), tile_type::size(),
+                              data.get() + index * tile_type::size());
+                  ++index;
+                }
+              });
+        }
+      });
+
+  return output_type{input.extents(), row_offsets, columns, data};
+}
+
+constexpr auto to_block_sparse() -> tt::to_block_sparse_view { return {}; }
+
+// scatters the stored tiles into a zero-initialized dense matrix
+template <class T, class TTiledLayout, class TLayout>
+auto operator|(const tt::block_sparse_matrix<T, TTiledLayout> &input,
+               const tt::to_layout_view<TLayout> &) {
+  using input_type = tt::block_sparse_matrix<T, TTiledLayout>;
+  using extents_type = typename input_type::extents_type;
+  using mapping_type = typename TLayout::template mapping<extents_type>;
+  using output_type = tt::Tensor<T, extents_type, TLayout>;
+  using tile_type = typename input_type::tile_type;
+  using index_type = typename input_type::index_type;
+
+  tt::profile_scope scope{"to_layout"};
+  const mapping_type mapping{input.extents()};
+  const output_type output{tt::make_shared<T[]>(mapping), mapping};
+  const auto output_view = tt::borrow(output);
+  const auto grain = tt::grain_size(input.tile_cols() * tile_type::size());
+
+  tt::parallel_for(0, input.tile_rows(), grain,
+                   [&](std::size_t first, std::size_t last) {
+                     for (auto tile_row = first; tile_row < last; ++tile_row) {
+                       input.for_each_tile(tile_row, [&](const auto &tile) {
+                         for (index_type row = 0; row < tile.rows; ++row) {
+                           for (index_type col = 0; col < tile.cols; ++col) {
+                             tile.at(output_view, row, col) = tile(row, col);
+                           }
+                         }
+                       });
+                     }
+                   });
+
+  scope.output(output);
+
+  return output;
+}
+
+} // namespace operators
+} // namespace tt
@@ -1,49 +1,371 @@
 #pragma once
 
+#include <tt/core/borrow.hpp>
 #include <tt/core/layout.hpp>
 #include <tt/core/memory.hpp>
 #include <tt/core/tensor.hpp>
+#include <tt/core/tile.hpp>
+#include <tt/operators/full.hpp>
+#include <tt/runtime/layout_cache.hpp>
+#include <tt/runtime/parallel_for.hpp>
+#include <tt/runtime/profiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <memory>
+#include <type_traits>
 
 namespace tt {
 inline namespace operators {
+namespace detail {
+namespace {
+
+// elements along the innermost extent that are stored contiguously
+template <class TLayout>
+constexpr auto contiguous_width() noexcept -> std::size_t {
+  if constexpr (tt::is_tiled_layout_v<TLayout>) {
+    return TLayout::contiguous_width;
+  } else if constexpr (std::is_same_v<TLayout, tt::RowMajor>) {
+    return std::dynamic_extent;
+  } else {
+    return 1;
+  }
+}
+
+// splits each row of a tile into the longest runs that are contiguous both in
+// the tile and in another layout of the same extents
+template <std::size_t OtherWidth, class TTile, class TCallback>
+constexpr auto for_each_run(const TTile &tile, TCallback callback) -> void {
+  using index_type = typename TTile::index_type;
+
+  constexpr index_type tile_width = TTile::layout_type::contiguous_width;
+
+  for (index_type row = 0; row < tile.rows; ++row) {
+    for (index_type col = 0; col < tile.cols;) {
+      const auto width = std::min({
+          tile.cols - col,
+          tile_width - col % tile_width,
+          OtherWidth - (tile.col + col) % OtherWidth,
+      });
+
+      callback(row, col, width);
+      col += width;
+    }
+  }
+}
+
+inline constexpr std::size_t transpose_block_extent = 8;
+
+// output(row, col) = input(row, col) where rows are contiguous in input and
+// columns are contiguous in output; staging a full block lets both the loads
+// and the stores run along contiguous memory
+template <class TInput, class TOutput>
+constexpr auto transpose_block(const TInput *input, std::size_t input_stride,
+                               TOutput *output,
+                               std::size_t output_stride) noexcept -> void {
+  constexpr auto extent = transpose_block_extent;
+
+  TOutput block[extent][extent];
+
+  for (std::size_t col = 0; col < extent; ++col) {
+    for (std::size_t row = 0; row < extent; ++row) {
+      block[row][col] = input[row + col * input_stride];
+    }
+  }
+
+  for (std::size_t row = 0; row < extent; ++row) {
+    for (std::size_t col = 0; col < extent; ++col) {
+      output[row * output_stride + col] = block[row][col];
+    }
+  }
+}
+
+// cache-oblivious transpose: halves the longer side on block boundaries until
+// the pieces fit a block, so every level of the cache hierarchy is reused
+// without tuning for its size
+template <class TInput, class TOutput>
+constexpr auto transpose_blocks(const TInput *input, std::size_t input_stride,
+                                TOutput *output, std::size_t output_stride,
+                                std::size_t rows,
+                                std::size_t cols) noexcept -> void {
+  constexpr auto extent = transpose_block_extent;
+
+  if (rows == extent and cols == extent) {
+    detail::transpose_block(input, input_stride, output, output_stride);
+  } else if (rows <= extent and cols <= extent) {
+    for (std::size_t col = 0; col < cols; ++col) {
+      for (std::size_t row = 0; row < rows; ++row) {
+        output[row * output_stride + col] = input[row + col * input_stride];
+      }
+    }
+  } else if (rows >= cols) {
+    const auto half = std::max(rows / 2 / extent * extent, extent);
+
+    detail::transpose_blocks(input, input_stride, output, output_stride, half,
+                             cols);
+    detail::transpose_blocks(input + half, input_stride,
+                             output + half * output_stride, output_stride,
+                             rows - half, cols);
+  } else {
+    const auto half = std::max(cols / 2 / extent * extent, extent);
+
+    detail::transpose_blocks(input, input_stride, output, output_stride, rows,
+                             half);
+    detail::transpose_blocks(input + half * input_stride, input_stride,
+                             output + half, output_stride, rows, cols - half);
+  }
+}
+
+// copies between strided layouts whose unit-stride extents differ, e.g. when
+// materializing a permuted view, as transposed bands of block rows of each
+// plane spanned by the two unit-stride extents
+template <class TInput, class TOutput>
+auto copy_transposed(const TInput &input, const TOutput &output,
+                     std::size_t input_axis, std::size_t output_axis) -> void {
+  constexpr auto rank = TOutput::rank();
+  constexpr auto extent = detail::transpose_block_extent;
+
+  const auto input_data = input.data_handle();
+  const auto output_data = output.data_handle();
+  const auto rows = output.extent(input_axis);
+  const auto cols = output.extent(output_axis);
+  const auto row_blocks = (rows + extent - 1) / extent;
+  std::size_t planes = 1;
+
+  for (std::size_t r = 0; r < rank; ++r) {
+    if (r != input_axis and r != output_axis) {
+      planes *= output.extent(r);
+    }
+  }
+
+  if (output.empty()) {
+    return;
+  }
+
+  tt::parallel_for(
+      0, planes * row_blocks, tt::grain_size(extent * cols),
+      [&](std::size_t first, std::size_t last) {
+        while (first < last) {
+          const auto plane = first / row_blocks;
+          const auto block_begin = first % row_blocks;
+          const auto block_end =
+              std::min(row_blocks, block_begin + last - first);
+          const auto row = block_begin * extent;
+          std::size_t input_offset = row * input.stride(input_axis);
+          std::size_t output_offset = row * output.stride(input_axis);
+
+          for (std::size_t r = rank, index = plane; r-- > 0;) {
+            if (r == input_axis or r == output_axis) {
+              continue;
+            }
+
+            input_offset += index % output.extent(r) * input.stride(r);
+            output_offset += index % output.extent(r) * output.stride(r);
+            index /= output.extent(r);
+          }
+
+          detail::transpose_blocks(
+              input_data + input_offset, input.stride(output_axis),
+              output_data + output_offset, output.stride(input_axis),
+              std::min(rows, block_end * extent) - row, cols);
+
+          first += block_end - block_begin;
+        }
+      });
+}
+
+// extent with unit stride, or rank if there is none
+template <class TInput>
+constexpr auto unit_stride_axis(const TInput &input) -> std::size_t {
+  for (std::size_t r = TInput::rank(); r-- > 0;) {
+    if (input.stride(r) == 1 and input.extent(r) > 1) {
+      return r;
+    }
+  }
+
+  return TInput::rank();
+}
+
+// copies the elements of the input into an output of the same extents
+template <class TInput, class TOutput>
+auto copy_layout(const TInput &input, const TOutput &output) -> void {
+  using index_type = tt::index_type_t<TOutput>;
+
+  const auto input_view = tt::borrow(input);
+  const auto output_view = tt::borrow(output);
+
+  if constexpr (tt::tiled<TOutput>) {
+    constexpr auto input_width =
+        detail::contiguous_width<tt::layout_type_t<TInput>>();
+
+    tt::parallel_for_each_tile(output_view, [&](const auto &tile) {
+      detail::for_each_run<input_width>(
+          tile, [&](index_type row, index_type col, index_type width) {
+            if constexpr (tt::generated<TInput>) {
+              // generated elements have no address to copy from
+              for (index_type offset = 0; offset < width; ++offset) {
+                tile(row, col + offset) =
+                    tile.at(input_view, row, col + offset);
+              }
+            } else {
+              std::copy_n(&tile.at(input_view, row, col), width,
+                          &tile(row, col));
+            }
+          });
+    });
+  } else if constexpr (tt::tiled<TInput> and not tt::generated<TInput>) {
+    constexpr auto output_width =
+        detail::contiguous_width<tt::layout_type_t<TOutput>>();
+
+    tt::parallel_for_each_tile(input_view, [&](const auto &tile) {
+      detail::for_each_run<output_width>(
+          tile, [&](index_type row, index_type col, index_type width) {
+            std::copy_n(&tile(row, col), width,
+                        &tile.at(output_view, row, col));
+          });
+    });
+  } else {
+    if constexpr (TOutput::rank() >= 2 and not tt::generated<TInput> and
+                  TInput::is_always_strided() and
+                  TOutput::is_always_strided()) {
+      const auto input_axis = detail::unit_stride_axis(input_view);
+      const auto output_axis = detail::unit_stride_axis(output_view);
+
+      if (input_axis < TOutput::rank() and
+          output_axis < TOutput::rank() and input_axis != output_axis) {
+        detail::copy_transposed(input_view, output_view, input_axis,
+                                output_axis);
+
+        return;
+      }
+    }
+
+    const auto recur = [&](const auto &recur, auto... indices) {
+      constexpr auto rank = sizeof...(indices);
+
+      if constexpr (rank == TOutput::rank()) {
+        output_view(indices...) = input_view(indices...);
+      } else {
+        for (index_type index = 0; index < output.extent(rank); ++index) {
+          recur(recur, indices..., index);
+        }
+      }
+    };
+
+    if constexpr (TOutput::rank() == 0) {
+      recur(recur);
+    } else {
+      const std::size_t extent = output.extent(0);
+
+      const auto grain =
+          tt::grain_size(output.size() / std::max<std::size_t>(extent, 1));
+
+      tt::parallel_for(0, extent, grain,
+                       [&](std::size_t first, std::size_t last) {
+                         for (auto index = first; index < last; ++index) {
+                           recur(recur, static_cast<index_type>(index));
+                         }
+                       });
+    }
+  }
+}
+
+// copies the input into a new buffer in TLayout
+template <class TLayout, class TInput>
+auto convert_layout(const TInput &input) {
+  using element_type = tt::element_type_t<TInput>;
+  using extents_type = tt::extents_type_t<TInput>;
+  using mapping_type = typename TLayout::template mapping<extents_type>;
+  using output_type = tt::Tensor<element_type, extents_type, TLayout>;
+
+  tt::profile_scope scope{"to_layout", input};
+  const mapping_type mapping{input.extents()};
+  const output_type output{
+      mapping.is_exhaustive()
+          ? tt::make_shared_for_overwrite<element_type[]>(mapping)
+          : tt::make_shared<element_type[]>(mapping),
+      mapping};
+
+  detail::copy_layout(input, output);
+  scope.output(output);
+
+  return output;
+}
+
+} // namespace
+} // namespace detail
 
 template <class TLayout>
 struct to_layout_view {};
 
 using to_row_major_view = tt::to_layout_view<tt::RowMajor>;
+using to_col_major_view = tt::to_layout_view<tt::ColMajor>;
 using to_tiled_view = tt::to_layout_view<tt::Tiled>;
+using to_tiled_faces_view = tt::to_layout_view<tt::TiledFaces>;
 
+// a tensor that already has the layout is returned as it is, sharing its
+// buffer; conversions of owned buffers go through tt::get_layout_cache() while
+// it is enabled
 template <class TInput, class TLayout,
           class = std::enable_if_t<tt::tensor<TInput>>>
 constexpr auto operator|(const TInput &input,
                          const tt::to_layout_view<TLayout> &) {
   using element_type = tt::element_type_t<TInput>;
   using extents_type = tt::extents_type_t<TInput>;
-  using mapping_type = typename TLayout::template mapping<extents_type>;
   using output_type = tt::Tensor<element_type, extents_type, TLayout>;
-  using index_type = tt::index_type_t<output_type>;
 
-  const mapping_type mapping{input.extents()};
-  const auto count = mapping.required_span_size();
-  const output_type output{
-      mapping.is_exhaustive()
-          ? tt::make_shared_for_overwrite<element_type[]>(count)
-          : tt::make_shared<element_type[]>(count),
-      mapping};
+  constexpr bool cacheable =
+      std::is_same_v<typename TInput::data_handle_type,
+                     std::shared_ptr<element_type[]>>;
 
-  const auto recur = [&](const auto &recur, auto... indices) {
-    constexpr auto rank = sizeof...(indices);
+  if constexpr (std::is_same_v<TInput, output_type>) {
+    return input;
+  } else if constexpr (cacheable) {
+    auto &cache = tt::get_layout_cache();
 
-    if constexpr (rank == output_type::rank()) {
-      output(indices...) = input(indices...);
-    } else {
-      for (index_type index = 0; index < output.extent(rank); ++index) {
-        recur(recur, indices..., index);
-      }
+    if (not cache.enabled()) {
+      return detail::convert_layout<TLayout>(input);
+    }
+
+    if (auto output = cache.find<output_type>(input)) {
+      return *std::move(output);
+    }
+
+    const auto output = detail::convert_layout<TLayout>(input);
+
+    cache.insert(input, output);
+
+    return output;
+  } else {
+    return detail::convert_layout<TLayout>(input);
+  }
+}
+
+// copies the input into an existing tensor of the same extents in any layout
+// instead of a new buffer, which must not share elements with the input;
+// padding of its tiles is zeroed as in a new one
+template <class TOutput, class TInput,
+          class = std::enable_if_t<tt::tensor<TInput> and
+                                   tt::writable<TOutput> and
+                                   TInput::rank() == TOutput::rank()>>
+auto to_layout_out(const TOutput &output, const TInput &input) -> TOutput {
+  using element_type = tt::element_type_t<TOutput>;
+
+  assert(input.extents() == output.extents());
+  assert(not tt::runtime::detail::overlaps(output, input));
+
+  tt::profile_scope scope{"to_layout", input};
+
+  if constexpr (tt::tiled<TOutput>) {
+    if (not output.is_exhaustive()) {
+      detail::fill_span(output, element_type{});
     }
-  };
+  }
 
-  recur(recur);
+  detail::copy_layout(input, output);
+  tt::get_layout_cache().invalidate(output);
+  scope.output(output);
 
   return output;
 }
@@ -55,7 +377,18 @@ constexpr auto to_layout() -> tt::to_layout_view<TLayout> {
 
 constexpr auto to_row_major() { return tt::to_layout<tt::layout::RowMajor>(); }
 
-constexpr auto to_tiled() { return tt::to_layout<tt::layout::Tiled>(); }
+constexpr auto to_col_major() { return tt::to_layout<tt::layout::ColMajor>(); }
+
+template <std::size_t TileHeight = tt::default_tile_extent,
+          std::size_t TileWidth = TileHeight>
+constexpr auto to_tiled()
+    -> tt::to_layout_view<tt::layout_right_tiled<TileHeight, TileWidth>> {
+  return {};
+}
+
+constexpr auto to_tiled_faces() {
+  return tt::to_layout<tt::layout::TiledFaces>();
+}
 
 } // namespace operators
 } // namespace tt
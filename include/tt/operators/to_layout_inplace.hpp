@@ -0,0 +1,197 @@
+#pragma once
+
+#include <tt/core/borrow.hpp>
+#include <tt/core/layout.hpp>
+#include <tt/core/tensor.hpp>
+#include <tt/runtime/layout_cache.hpp>
+#include <tt/runtime/parallel_for.hpp>
+#include <tt/runtime/profiler.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <type_traits>
+#include <vector>
+
+namespace tt {
+inline namespace operators {
+namespace detail {
+namespace {
+
+// transposes a rows x cols row-major grid of chunks of Width elements within
+// its own storage, following each cycle of the permutation with one chunk in
+// hand; moved is scratch for one flag per chunk
+template <std::size_t Width, class T>
+auto transpose_chunks(T *data, std::size_t rows, std::size_t cols,
+                      std::vector<bool> &moved) -> void {
+  const auto count = rows * cols;
+
+  if (rows == 1 or cols == 1) {
+    return;
+  }
+
+  std::array<T, Width> chunk;
+
+  moved.assign(count, false);
+
+  // the first and last chunks stay where they are
+  for (std::size_t start = 1; start + 1 < count; ++start) {
+    if (moved[start]) {
+      continue;
+    }
+
+    std::copy_n(data + start * Width, Width, chunk.begin());
+
+    auto index = start;
+
+    do {
+      // chunk (row, col) at index row * cols + col moves to col * rows + row
+      index = index * rows % (count - 1);
+      std::swap_ranges(chunk.begin(), chunk.end(), data + index * Width);
+      moved[index] = true;
+    } while (index != start);
+  }
+}
+
+// reorders a tile stored row-major into the order of TLayout, or back
+template <class TLayout, bool ToTiled, class T>
+auto permute_tile(T *data) -> void {
+  std::array<T, TLayout::tile_size> tile;
+
+  std::copy_n(data, TLayout::tile_size, tile.begin());
+
+  for (std::size_t row = 0; row < TLayout::tile_height; ++row) {
+    for (std::size_t col = 0; col < TLayout::tile_width; ++col) {
+      const auto row_major = row * TLayout::tile_width + col;
+      const auto tiled = TLayout::offset_in_tile(row, col);
+
+      if constexpr (ToTiled) {
+        data[tiled] = tile[row_major];
+      } else {
+        data[row_major] = tile[tiled];
+      }
+    }
+  }
+}
+
+// converts each band of tile_height rows of every matrix between row-major
+// and TLayout: a band is a grid of tile_height x tile_cols row segments in
+// row-major order and tile_cols x tile_height of them in tiled order
+template <class TLayout, bool ToTiled, class T>
+auto relayout_bands(T *data, std::size_t matrices, std::size_t rows,
+                    std::size_t cols) -> void {
+  constexpr auto tile_height = TLayout::tile_height;
+  constexpr auto tile_width = TLayout::tile_width;
+  // tiles whose rows are contiguous are row-major within the tile
+  constexpr bool row_major_tiles = TLayout::contiguous_width == tile_width;
+
+  const auto band_size = tile_height * cols;
+  const auto tile_cols = cols / tile_width;
+  const auto bands = matrices * (rows / tile_height);
+
+  tt::parallel_for(
+      0, bands, tt::grain_size(band_size),
+      [&](std::size_t first, std::size_t last) {
+        std::vector<bool> moved;
+
+        for (auto band = first; band < last; ++band) {
+          const auto band_data = data + band * band_size;
+
+          if constexpr (ToTiled) {
+            detail::transpose_chunks<tile_width>(band_data, tile_height,
+                                                 tile_cols, moved);
+          }
+
+          if constexpr (not row_major_tiles) {
+            for (std::size_t tile = 0; tile < tile_cols; ++tile) {
+              detail::permute_tile<TLayout, ToTiled>(
+                  band_data + tile * TLayout::tile_size);
+            }
+          }
+
+          if constexpr (not ToTiled) {
+            detail::transpose_chunks<tile_width>(band_data, tile_cols,
+                                                 tile_height, moved);
+          }
+        }
+      });
+}
+
+} // namespace
+} // namespace detail
+
+// Reorders the elements of a row-major or tiled tensor into TLayout within
+// its own buffer and returns a view of it in the new layout, so that peak
+// memory does not double as with tt::to_layout. The input must not be read
+// afterwards. Both layouts must be exhaustive, i.e. the innermost extents are
+// multiples of the tile extents, so that they span the same storage.
+template <class TLayout, class TInput,
+          class = std::enable_if_t<tt::tensor<TInput> and
+                                   not tt::generated<TInput> and
+                                   TInput::rank() >= 2>>
+auto to_layout_(const TInput &input) {
+  using element_type = tt::element_type_t<TInput>;
+  using extents_type = tt::extents_type_t<TInput>;
+  using input_layout_type = tt::layout_type_t<TInput>;
+  using mapping_type = typename TLayout::template mapping<extents_type>;
+  using output_type = std::mdspan<element_type, extents_type, TLayout,
+                                  typename TInput::accessor_type>;
+
+  constexpr auto rank = TInput::rank();
+
+  static_assert(std::is_same_v<input_layout_type, tt::RowMajor> or
+                tt::is_tiled_layout_v<input_layout_type>);
+  static_assert(std::is_same_v<TLayout, tt::RowMajor> or
+                tt::is_tiled_layout_v<TLayout>);
+
+  if constexpr (std::is_same_v<input_layout_type, TLayout>) {
+    return input;
+  } else if constexpr (tt::tiled<TInput> and tt::is_tiled_layout_v<TLayout>) {
+    // between tiled layouts through row-major
+    return tt::to_layout_<TLayout>(tt::to_layout_<tt::RowMajor>(input));
+  } else {
+    using tiled_layout_type =
+        std::conditional_t<tt::tiled<TInput>, input_layout_type, TLayout>;
+    using tiled_mapping_type =
+        typename tiled_layout_type::template mapping<extents_type>;
+
+    tt::profile_scope scope{"to_layout_", input};
+    const mapping_type mapping{input.extents()};
+    const auto data = tt::borrow(input).data_handle();
+    const std::size_t rows = input.extent(rank - 2);
+    const std::size_t cols = input.extent(rank - 1);
+    std::size_t matrices = 1;
+
+    assert(tiled_mapping_type{input.extents()}.is_exhaustive());
+
+    for (std::size_t r = 0; r + 2 < rank; ++r) {
+      matrices *= input.extent(r);
+    }
+
+    detail::relayout_bands<tiled_layout_type, tt::is_tiled_layout_v<TLayout>>(
+        data, matrices, rows, cols);
+
+    // conversions of the buffer were of the elements in their old order
+    tt::get_layout_cache().invalidate(input);
+
+    const output_type output{input.data_handle(), mapping};
+
+    scope.output(output);
+
+    return output;
+  }
+}
+
+template <std::size_t TileHeight = tt::default_tile_extent,
+          std::size_t TileWidth = TileHeight, class TInput>
+auto to_tiled_(const TInput &input) {
+  return tt::to_layout_<tt::layout_right_tiled<TileHeight, TileWidth>>(input);
+}
+
+template <class TInput>
+auto to_row_major_(const TInput &input) {
+  return tt::to_layout_<tt::RowMajor>(input);
+}
+
+} // namespace operators
+} // namespace tt
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <tt/core/borrow.hpp>
+#include <tt/core/memory.hpp>
+#include <tt/core/sparse.hpp>
+#include <tt/core/tensor.hpp>
+#include <tt/operators/to_layout.hpp>
+#include <tt/runtime/parallel_for.hpp>
+#include <tt/runtime/profiler.hpp>
+
+#include <numeric>
+
+namespace tt {
+inline namespace operators {
+namespace detail {
+namespace {
+
+// first row r whose work before it, counting each row and each stored element
+// once, is at least work
+constexpr auto row_at_work(const std::size_t *row_offsets, std::size_t rows,
+                           std::size_t work) noexcept -> std::size_t {
+  std::size_t first = 0;
+  std::size_t last = rows;
+
+  while (first < last) {
+    const auto row = first + (last - first) / 2;
+
+    if (row_offsets[row] + row < work) {
+      first = row + 1;
+    } else {
+      last = row;
+    }
+  }
+
+  return first;
+}
+
+} // namespace
+} // namespace detail
+
+// calls callback(first, last) on disjoint ranges of the rows of a sparse
+// matrix, split so that each range holds about as many rows plus stored
+// elements as the others, however unevenly the elements fall across rows; work
+// is the elements of the output touched per stored element
+template <class T, class TCallback>
+auto parallel_for_rows(const tt::csr_matrix<T> &input, std::size_t work,
+                       const TCallback &callback) -> void {
+  const auto row_offsets = input.row_offsets().get();
+  const auto rows = input.extent(0);
+
+  tt::parallel_for(0, rows + input.nnz(), tt::grain_size(work),
+                   [&](std::size_t first, std::size_t last) {
+                     const auto first_row =
+                         detail::row_at_work(row_offsets, rows, first);
+                     const auto last_row =
+                         detail::row_at_work(row_offsets, rows, last);
+
+                     if (first_row < last_row) {
+                       callback(first_row, last_row);
+                     }
+                   });
+}
+
+struct to_csr_view {};
+struct to_coo_view {};
+
+// stores the non-zero elements of a matrix in any layout, in two passes over
+// its rows: one to count the elements of each row and one to copy them
+template <class TInput, class = std::enable_if_t<tt::matrix<TInput>>>
+auto operator|(const TInput &input, const tt::to_csr_view &) {
+  using element_type = std::remove_cv_t<tt::element_type_t<TInput>>;
+  using output_type = tt::csr_matrix<element_type>;
+  using index_type = typename output_type::index_type;
+
+  tt::profile_scope scope{"to_csr", input};
+  const auto input_view = tt::borrow(input);
+  const index_type rows = input.extent(0);
+  const index_type cols = input.extent(1);
+  const auto grain = tt::grain_size(cols);
+
+  // elements per row, after the leading zero of the offsets
+  const auto row_offsets = tt::make_shared<index_type[]>(rows + 1);
+
+  tt::parallel_for(0, rows, grain, [&](std::size_t first, std::size_t last) {
+    for (auto row = first; row < last; ++row) {
+      for (index_type col = 0; col < cols; ++col) {
+        row_offsets[row + 1] += input_view(row, col) != element_type{};
+      }
+    }
+  });
+
+  std::partial_sum(row_offsets.get(), row_offsets.get() + rows + 1,
+                   row_offsets.get());
+
+  const auto nnz = row_offsets[rows];
+  const auto columns = tt::make_shared_for_overwrite<index_type[]>(nnz);
+  const auto values = tt::make_shared_for_overwrite<element_type[]>(nnz);
+
+  tt::parallel_for(0, rows, grain, [&](std::size_t first, std::size_t last) {
+    for (auto row = first; row < last; ++row) {
+      auto index = row_offsets[row];
+
+      for (index_type col = 0; col < cols; ++col) {
+        const element_type value = input_view(row, col);
+
+        if (value != element_type{}) {
+          columns[index] = col;
+          values[index] = value;
+          ++index;
+        }
+      }
+    }
+  });
+
+  return output_type{input.extents(), row_offsets, columns, values};
+}
+
+// shares the columns and values of the input, which are already in row-major
+// order
+template <class T>
+auto operator|(const tt::csr_matrix<T> &input, const tt::to_coo_view &) {
+  using index_type = typename tt::csr_matrix<T>::index_type;
+
+  const auto row_offsets = input.row_offsets().get();
+  const auto rows = tt::make_shared_for_overwrite<index_type[]>(input.nnz());
+
+  tt::parallel_for_rows(input, 1, [&](std::size_t first, std::size_t last) {
+    for (auto row = first; row < last; ++row) {
+      std::fill(rows.get() + row_offsets[row],
+                rows.get() + row_offsets[row + 1], row);
+    }
+  });
+
+  return tt::coo_matrix<T>{input.extents(), input.nnz(), rows,
+                           input.columns(), input.values()};
+}
+
+template <class T>
+auto operator|(const tt::coo_matrix<T> &input, const tt::to_csr_view &) {
+  using index_type = typename tt::coo_matrix<T>::index_type;
+
+  const auto rows = input.extent(0);
+  const auto row_indices = input.rows().get();
+  const auto row_offsets = tt::make_shared<index_type[]>(rows + 1);
+
+  for (index_type index = 0; index < input.nnz(); ++index) {
+    ++row_offsets[row_indices[index] + 1];
+  }
+
+  std::partial_sum(row_offsets.get(), row_offsets.get() + rows + 1,
+                   row_offsets.get());
+
+  return tt::csr_matrix<T>{input.extents(), row_offsets, input.columns(),
+                           input.values()};
+}
+
+template <class TInput, class = std::enable_if_t<tt::matrix<TInput>>>
+auto operator|(const TInput &input, const tt::to_coo_view &) {
+  return input | tt::to_csr_view{} | tt::to_coo_view{};
+}
+
+constexpr auto to_csr() -> tt::to_csr_view { return {}; }
+
+constexpr auto to_coo() -> tt::to_coo_view { return {}; }
+
+// scatters the stored elements into a zero-initialized dense matrix
+template <class T, class TLayout>
+auto operator|(const tt::csr_matrix<T> &input,
+               const tt::to_layout_view<TLayout> &) {
+  using extents_type = typename tt::csr_matrix<T>::extents_type;
+  using mapping_type = typename TLayout::template mapping<extents_type>;
+  using output_type = tt::Tensor<T, extents_type, TLayout>;
+
+  tt::profile_scope scope{"to_layout"};
+  const mapping_type mapping{input.extents()};
+  const output_type output{tt::make_shared<T[]>(mapping), mapping};
+  const auto output_view = tt::borrow(output);
+  const auto row_offsets = input.row_offsets().get();
+  const auto columns = input.columns().get();
+  const auto values = input.values().get();
+
+  tt::parallel_for_rows(input, 1, [&](std::size_t first, std::size_t last) {
+    for (auto row = first; row < last; ++row) {
+      for (auto index = row_offsets[row]; index < row_offsets[row + 1];
+           ++index) {
+        output_view(row, columns[index]) = values[index];
+      }
+    }
+  });
+
+  scope.output(output);
+
+  return output;
+}
+
+template <class T, class TLayout>
+auto operator|(const tt::coo_matrix<T> &input,
+               const tt::to_layout_view<TLayout> &view) {
+  return input | tt::to_csr_view{} | view;
+}
+
+} // namespace operators
+} // namespace tt
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <tt/operators/permute.hpp>
+
+namespace tt {
+inline namespace operators {
+
+// reverses the order of the extents, e.g. swaps rows and columns of a matrix
+struct transpose_view {
+  template <class TInput, class = std::enable_if_t<tt::tensor<TInput> and
+                                                   TInput::is_always_strided()>>
+  friend constexpr auto operator|(const TInput &input, const transpose_view &) {
+    constexpr auto rank = TInput::rank();
+
+    std::array<std::size_t, rank> axes{};
+
+    for (std::size_t r = 0; r < rank; ++r) {
+      axes[r] = rank - 1 - r;
+    }
+
+    return input | tt::permute_view<rank>{axes};
+  }
+};
+
+constexpr auto transpose() -> tt::transpose_view { return {}; }
+
+} // namespace operators
+} // namespace tt
@@ -1,14 +1,56 @@
 #pragma once
 
+#include <tt/core/dtype.hpp>
+#include <tt/core/float.hpp>
+#include <tt/core/inline_accessor.hpp>
+#include <tt/core/layout.hpp>
+#include <tt/core/memory.hpp>
+#include <tt/core/tensor.hpp>
 #include <tt/operators/full.hpp>
+#include <tt/runtime/profiler.hpp>
 
 namespace tt {
 inline namespace operators {
 
+// value-initializes instead of filling, so that the buffer of a large tensor
+// is zeroed a page at a time as it is first touched rather than up front
 template <auto... Vs, class... TIndices>
 constexpr auto zeros(TIndices... extents) {
-  return tt::full<Vs...>(0.f, extents...);
+  using extents_type = tt::extents_from<TIndices...>;
+  using element_type = tt::type_t<tt::dtypes, tt::dtype::Float32, Vs...>;
+  using layout_type = tt::type_t<tt::layouts, tt::layout::RowMajor, Vs...>;
+  using output_type = tt::Tensor<element_type, extents_type, layout_type>;
+
+  tt::profile_scope scope{"zeros"};
+  const typename layout_type::template mapping<extents_type> mapping{
+      extents_type{extents...}};
+  const output_type output{tt::make_shared<element_type[]>(mapping), mapping};
+
+  scope.output(output);
+
+  return output;
+}
+
+template <class TOutput, class = std::enable_if_t<tt::writable<TOutput>>>
+auto zeros_out(const TOutput &output) -> TOutput {
+  return tt::full_out(output, tt::element_type_t<TOutput>{});
+}
+
+namespace fixed {
+
+// tensor that holds its zeros by value, for extents that are all integral
+// constants, e.g. tt::fixed::zeros(tt::size_constant<3>{}) for a point
+template <auto... Vs, class... TIndices>
+constexpr auto zeros(TIndices...) noexcept {
+  using extents_type = tt::extents_from<TIndices...>;
+  using element_type = tt::type_t<tt::dtypes, tt::dtype::Float32, Vs...>;
+  using layout_type = tt::type_t<tt::layouts, tt::layout::RowMajor, Vs...>;
+  using output_type =
+      tt::InlineTensor<element_type, extents_type, layout_type>;
+
+  return output_type{typename output_type::data_handle_type{}};
 }
 
+} // namespace fixed
 } // namespace operators
 } // namespace tt
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace tt {
+inline namespace runtime {
+
+// queue of at most capacity items between threads: push blocks while it is
+// full and pop while it is empty, which bounds how far producers run ahead of
+// consumers; once closed, pushes are refused and pops drain what is left
+template <class T>
+class bounded_queue {
+  std::mutex mutex;
+  std::condition_variable not_empty;
+  std::condition_variable not_full;
+  std::deque<T> items;
+  std::size_t capacity;
+  bool closed = false;
+
+public:
+  explicit bounded_queue(std::size_t capacity) : capacity(capacity) {
+    assert(capacity > 0);
+  }
+
+  // false if the queue was closed before there was room for the item
+  auto push(T item) -> bool {
+    {
+      std::unique_lock lock{this->mutex};
+
+      this->not_full.wait(lock, [&] {
+        return this->closed or this->items.size() < this->capacity;
+      });
+
+      if (this->closed) {
+        return false;
+      }
+
+      this->items.push_back(std::move(item));
+    }
+
+    this->not_empty.notify_one();
+
+    return true;
+  }
+
+  // nullopt once the queue is closed and empty
+  auto pop() -> std::optional<T> {
+    std::optional<T> item;
+
+    {
+      std::unique_lock lock{this->mutex};
+
+      this->not_empty.wait(
+          lock, [&] { return this->closed or not this->items.empty(); });
+
+      if (this->items.empty()) {
+        return std::nullopt;
+      }
+
+      item = std::move(this->items.front());
+      this->items.pop_front();
+    }
+
+    this->not_full.notify_one();
+
+    return item;
+  }
+
+  auto close() -> void {
+    {
+      const std::lock_guard lock{this->mutex};
+
+      this->closed = true;
+    }
+
+    this->not_empty.notify_all();
+    this->not_full.notify_all();
+  }
+};
+
+} // namespace runtime
+} // namespace tt
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <tt/runtime/event.hpp>
+#include <tt/runtime/layout_cache.hpp>
+#include <tt/runtime/profiler.hpp>
+#include <tt/runtime/thread_pool.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace tt {
+inline namespace runtime {
+namespace detail {
+
+// waits for the value of a pending argument; other arguments pass through
+template <class T>
+auto resolve(const T &arg) -> const T & {
+  return arg;
+}
+
+template <class T>
+auto resolve(const tt::pending<T> &arg) -> const T & {
+  return arg.get();
+}
+
+template <class T>
+using resolved_t = std::remove_cv_t<
+    std::remove_reference_t<decltype(detail::resolve(std::declval<T>()))>>;
+
+} // namespace detail
+
+// runs commands one at a time, in the order they were enqueued, on a thread
+// of its own; a command waits for the pending arguments it was given, so
+// commands on different queues overlap unless one consumes the result of
+// another
+class command_queue {
+  std::mutex mutex;
+  std::condition_variable enqueued;
+  std::deque<std::function<void()>> commands;
+  bool stopping = false;
+  // set once the queue is destroyed, which gives up waiting on the event a
+  // command waits on
+  std::atomic<bool> abandoned{false};
+  std::optional<tt::event> waiting;
+  std::thread thread;
+
+  auto work() -> void {
+    for (;;) {
+      std::function<void()> command;
+
+      {
+        std::unique_lock lock{this->mutex};
+
+        this->enqueued.wait(lock, [&] {
+          return this->stopping or not this->commands.empty();
+        });
+
+        if (this->commands.empty()) {
+          return;
+        }
+
+        command = std::move(this->commands.front());
+        this->commands.pop_front();
+      }
+
+      command();
+    }
+  }
+
+  auto push(std::function<void()> command) -> void {
+    {
+      const std::lock_guard lock{this->mutex};
+
+      this->commands.push_back(std::move(command));
+    }
+
+    this->enqueued.notify_one();
+  }
+
+public:
+  command_queue() : thread([this] { this->work(); }) {}
+
+  command_queue(const command_queue &) = delete;
+
+  auto operator=(const command_queue &) -> command_queue & = delete;
+
+  // runs the commands already enqueued before returning, except that those
+  // waiting on an event that has not completed fail instead, so that an event
+  // that never completes cannot hang the destructor
+  ~command_queue() {
+    this->abandoned.store(true);
+
+    {
+      const std::lock_guard lock{this->mutex};
+
+      this->stopping = true;
+
+      if (this->waiting) {
+        this->waiting->interrupt();
+      }
+    }
+
+    this->enqueued.notify_one();
+    this->thread.join();
+  }
+
+  // enqueues function(args...) with each pending argument replaced by its
+  // value, returning a pending result, or an event if the result is void; an
+  // exception thrown by the command or by a pending argument is rethrown by
+  // the result
+  template <class TFunction, class... TArgs>
+  auto enqueue(TFunction function, TArgs... args) {
+    using result_type =
+        std::invoke_result_t<const TFunction &,
+                             const detail::resolved_t<TArgs> &...>;
+    using output_type = std::conditional_t<std::is_void_v<result_type>,
+                                           tt::event, tt::pending<result_type>>;
+
+    const output_type output{};
+
+    this->push([=] {
+      try {
+        if constexpr (std::is_void_v<result_type>) {
+          std::invoke(function, detail::resolve(args)...);
+          output.complete();
+        } else {
+          output.set_value(std::invoke(function, detail::resolve(args)...));
+        }
+      } catch (...) {
+        if constexpr (std::is_void_v<result_type>) {
+          output.complete(std::current_exception());
+        } else {
+          output.set_exception(std::current_exception());
+        }
+      }
+    });
+
+    return output;
+  }
+
+  // completes once every command enqueued before it has run
+  auto record() -> tt::event { return this->enqueue([] {}); }
+
+  // holds back the commands enqueued after it until the event completes
+  auto wait(const tt::event &event) -> void {
+    this->enqueue(
+        [this](const tt::event &event) {
+          {
+            const std::lock_guard lock{this->mutex};
+
+            this->waiting = event;
+          }
+
+          const auto completed =
+              event.wait_unless([this] { return this->abandoned.load(); });
+
+          {
+            const std::lock_guard lock{this->mutex};
+
+            this->waiting.reset();
+          }
+
+          if (not completed) {
+            throw std::runtime_error(
+                "command queue destroyed while waiting on an event");
+          }
+
+          event.wait();
+        },
+        event);
+  }
+
+  auto synchronize() -> void { this->record().wait(); }
+};
+
+// queue used by operators applied to pending tensors
+inline auto get_command_queue() -> tt::command_queue & {
+  // statics that commands use are constructed first, so that they are
+  // destroyed after the queue, whose destructor still runs commands
+  detail::get_shared_thread_pool();
+  tt::get_profiler();
+  tt::get_layout_cache();
+
+  static tt::command_queue queue;
+  return queue;
+}
+
+template <class TFunction, class... TArgs>
+auto enqueue(TFunction function, TArgs... args) {
+  return tt::get_command_queue().enqueue(std::move(function),
+                                         std::move(args)...);
+}
+
+inline auto synchronize() -> void { tt::get_command_queue().synchronize(); }
+
+// applies a view such as tt::to_tiled() once the input is ready, without
+// blocking the caller
+template <class T, class TView,
+          class = decltype(std::declval<const T &>() |
+                           std::declval<const TView &>())>
+auto operator|(const tt::pending<T> &input, const TView &view) {
+  return tt::enqueue(
+      [](const T &input, const TView &view) { return input | view; }, input,
+      view);
+}
+
+} // namespace runtime
+} // namespace tt
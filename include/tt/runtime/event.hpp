@@ -0,0 +1,145 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace tt {
+inline namespace runtime {
+namespace detail {
+
+struct event_state {
+  std::mutex mutex;
+  std::condition_variable completed;
+  bool done = false;
+  std::exception_ptr exception;
+
+  auto complete(std::exception_ptr error = nullptr) -> void {
+    {
+      const std::lock_guard lock{this->mutex};
+
+      this->exception = std::move(error);
+      this->done = true;
+    }
+
+    this->completed.notify_all();
+  }
+
+  auto ready() -> bool {
+    const std::lock_guard lock{this->mutex};
+
+    return this->done;
+  }
+
+  // blocks until complete or until stop() holds, which whoever makes it hold
+  // follows with interrupt(); returns whether the event completed
+  template <class TStop>
+  auto wait_unless(const TStop &stop) -> bool {
+    std::unique_lock lock{this->mutex};
+
+    this->completed.wait(lock, [&] { return this->done or stop(); });
+
+    return this->done;
+  }
+
+  auto interrupt() -> void {
+    {
+      const std::lock_guard lock{this->mutex};
+    }
+
+    this->completed.notify_all();
+  }
+
+  // blocks until complete and rethrows the exception it completed with
+  auto wait() -> void {
+    std::unique_lock lock{this->mutex};
+
+    this->completed.wait(lock, [&] { return this->done; });
+
+    if (this->exception) {
+      std::rethrow_exception(this->exception);
+    }
+  }
+};
+
+template <class T>
+struct pending_state : detail::event_state {
+  std::optional<T> value;
+
+  auto set_value(T result) -> void {
+    this->value.emplace(std::move(result));
+    this->complete();
+  }
+};
+
+} // namespace detail
+
+// completes once the command that recorded it has run; copies share the state
+class event {
+  std::shared_ptr<detail::event_state> state;
+
+public:
+  event() : state(std::make_shared<detail::event_state>()) {}
+
+  explicit event(std::shared_ptr<detail::event_state> state) noexcept
+      : state(std::move(state)) {}
+
+  auto ready() const -> bool { return this->state->ready(); }
+
+  auto wait() const -> void { this->state->wait(); }
+
+  template <class TStop>
+  auto wait_unless(const TStop &stop) const -> bool {
+    return this->state->wait_unless(stop);
+  }
+
+  auto interrupt() const -> void { this->state->interrupt(); }
+
+  auto complete(std::exception_ptr error = nullptr) const -> void {
+    this->state->complete(std::move(error));
+  }
+};
+
+// result of an enqueued command, such as a tensor that is still being computed
+template <class T>
+class pending {
+  std::shared_ptr<detail::pending_state<T>> state;
+
+public:
+  using value_type = T;
+
+  pending() : state(std::make_shared<detail::pending_state<T>>()) {}
+
+  auto ready() const -> bool { return this->state->ready(); }
+
+  auto wait() const -> void { this->state->wait(); }
+
+  // blocks until the command has run, rethrowing the exception it threw
+  auto get() const -> const T & {
+    this->wait();
+
+    return *this->state->value;
+  }
+
+  auto event() const -> tt::event { return tt::event{this->state}; }
+
+  auto set_value(T value) const -> void {
+    this->state->set_value(std::move(value));
+  }
+
+  auto set_exception(std::exception_ptr error) const -> void {
+    this->state->complete(std::move(error));
+  }
+};
+
+template <class T>
+inline constexpr bool is_pending_v = false;
+
+template <class T>
+inline constexpr bool is_pending_v<tt::pending<T>> = true;
+
+} // namespace runtime
+} // namespace tt
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <tt/core/borrow.hpp>
+#include <tt/core/concepts.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace tt {
+inline namespace runtime {
+namespace detail {
+
+// the source buffer, the types of the source and output tensors and the
+// extents and strides of the source, which together determine the output
+struct layout_cache_key {
+  const void *data;
+  std::type_index input_type;
+  std::type_index output_type;
+  std::vector<std::size_t> shape;
+
+  auto operator<(const layout_cache_key &rhs) const noexcept -> bool {
+    return std::tie(this->data, this->input_type, this->output_type,
+                    this->shape) <
+           std::tie(rhs.data, rhs.input_type, rhs.output_type, rhs.shape);
+  }
+};
+
+struct layout_cache_entry {
+  // owns the source buffer and expires with it, so that a buffer allocated
+  // later at the same address is not mistaken for it
+  std::weak_ptr<void> input;
+  std::shared_ptr<void> output;
+  // bytes of the source elements the output was converted from, and of the
+  // output
+  const std::byte *input_first;
+  const std::byte *input_last;
+  const std::byte *output_first;
+  const std::byte *output_last;
+};
+
+template <class T, class U>
+auto same_owner(const T &lhs, const U &rhs) noexcept -> bool {
+  return not lhs.owner_before(rhs) and not rhs.owner_before(lhs);
+}
+
+inline auto overlaps(const std::byte *first, const std::byte *last,
+                     const std::byte *other_first,
+                     const std::byte *other_last) noexcept -> bool {
+  return first < other_last and other_first < last;
+}
+
+// bytes spanned by the elements of a tensor
+template <class TInput>
+auto span_of(const TInput &input) noexcept
+    -> std::pair<const std::byte *, const std::byte *> {
+  const auto first =
+      reinterpret_cast<const std::byte *>(tt::borrow(input).data_handle());
+
+  return {first, first + input.mapping().required_span_size() *
+                             sizeof(tt::element_type_t<TInput>)};
+}
+
+// whether two tensors share any of the bytes of their elements, of which
+// generated tensors have none
+template <class TInput, class TOther>
+auto overlaps(const TInput &input, const TOther &other) noexcept -> bool {
+  if constexpr (tt::generated<TInput> or tt::generated<TOther>) {
+    return false;
+  } else {
+    const auto [first, last] = detail::span_of(input);
+    const auto [other_first, other_last] = detail::span_of(other);
+
+    return detail::overlaps(first, last, other_first, other_last);
+  }
+}
+
+template <class TInput>
+auto layout_cache_key_of(const TInput &input, const std::type_info &output)
+    -> layout_cache_key {
+  layout_cache_key key{input.data_handle().get(), typeid(TInput), output, {}};
+
+  for (std::size_t r = 0; r < TInput::rank(); ++r) {
+    key.shape.push_back(input.extent(r));
+  }
+
+  if constexpr (TInput::is_always_strided()) {
+    for (std::size_t r = 0; r < TInput::rank(); ++r) {
+      key.shape.push_back(input.stride(r));
+    }
+  }
+
+  return key;
+}
+
+} // namespace detail
+
+// Results of layout conversions of buffers that are still alive, which
+// tt::to_layout looks up while the cache is enabled so that converting the
+// same tensor again, e.g. weights every iteration, shares the earlier output
+// instead of copying. Operators that write into a tensor, e.g. the *_out ones
+// and tt::to_layout_, call invalidate() with it, which drops the conversions
+// of the whole allocation that owns it and detaches cached outputs it shares,
+// so that the next lookup copies afresh. Writes through element access are not
+// seen by the cache: call invalidate() after them, or clear(). Outputs are
+// shared between lookups, so the python bindings refuse to write into them.
+class layout_cache {
+  std::atomic<bool> active{false};
+  std::mutex mutex;
+  std::map<detail::layout_cache_key, detail::layout_cache_entry> entries;
+
+public:
+  auto enabled() const noexcept -> bool {
+    return this->active.load(std::memory_order_relaxed);
+  }
+
+  auto enable() noexcept -> void {
+    this->active.store(true, std::memory_order_relaxed);
+  }
+
+  auto disable() noexcept -> void {
+    this->active.store(false, std::memory_order_relaxed);
+  }
+
+  template <class TOutput, class TInput>
+  auto find(const TInput &input) -> std::optional<TOutput> {
+    using element_type = tt::element_type_t<TOutput>;
+    using mapping_type = typename TOutput::mapping_type;
+
+    const auto key = detail::layout_cache_key_of(input, typeid(TOutput));
+    const std::lock_guard lock{this->mutex};
+    const auto entry = this->entries.find(key);
+
+    if (entry == this->entries.end()) {
+      return std::nullopt;
+    }
+
+    // the same address in a buffer of another owner is another source
+    if (entry->second.input.expired() or
+        not detail::same_owner(entry->second.input, input.data_handle())) {
+      this->entries.erase(entry);
+
+      return std::nullopt;
+    }
+
+    const auto &output = entry->second.output;
+
+    return TOutput{
+        std::shared_ptr<element_type[]>{
+            output, static_cast<element_type *>(output.get())},
+        mapping_type{input.extents()},
+    };
+  }
+
+  // also drops the entries of sources that have since been freed
+  template <class TInput, class TOutput>
+  auto insert(const TInput &input, const TOutput &output) -> void {
+    auto key = detail::layout_cache_key_of(input, typeid(TOutput));
+    const std::lock_guard lock{this->mutex};
+
+    for (auto entry = this->entries.begin(); entry != this->entries.end();) {
+      entry = entry->second.input.expired() ? this->entries.erase(entry)
+                                            : std::next(entry);
+    }
+
+    const auto [input_first, input_last] = detail::span_of(input);
+    const auto [output_first, output_last] = detail::span_of(output);
+
+    this->entries.insert_or_assign(
+        std::move(key),
+        detail::layout_cache_entry{input.data_handle(), output.data_handle(),
+                                   input_first, input_last, output_first,
+                                   output_last});
+  }
+
+  // drops the conversions of the buffer of output and the cached outputs in
+  // it, after an operator wrote into it: those of its whole allocation if
+  // output owns its buffer, and those of the elements it spans if it borrows
+  // them
+  template <class TOutput, class = std::enable_if_t<tt::tensor<TOutput>>>
+  auto invalidate(const TOutput &output) -> void {
+    using element_type = tt::element_type_t<TOutput>;
+
+    constexpr bool owned =
+        std::is_same_v<typename TOutput::data_handle_type,
+                       std::shared_ptr<element_type[]>>;
+
+    const auto [first, last] = detail::span_of(output);
+    const std::lock_guard lock{this->mutex};
+
+    for (auto entry = this->entries.begin(); entry != this->entries.end();) {
+      const auto &value = entry->second;
+      bool written = detail::overlaps(first, last, value.input_first,
+                                      value.input_last) or
+                     detail::overlaps(first, last, value.output_first,
+                                      value.output_last);
+
+      if constexpr (owned) {
+        written = written or
+                  detail::same_owner(value.input, output.data_handle()) or
+                  detail::same_owner(value.output, output.data_handle());
+      }
+
+      entry = written ? this->entries.erase(entry) : std::next(entry);
+    }
+  }
+
+  // whether buffer is, or shares the allocation of, an output handed out by
+  // lookups, which other tensors may share
+  auto holds(const std::shared_ptr<void> &buffer) -> bool {
+    const std::lock_guard lock{this->mutex};
+
+    for (const auto &[key, value] : this->entries) {
+      if (not value.input.expired() and
+          detail::same_owner(value.output, buffer)) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  auto clear() -> void {
+    const std::lock_guard lock{this->mutex};
+
+    this->entries.clear();
+  }
+
+  auto size() -> std::size_t {
+    const std::lock_guard lock{this->mutex};
+
+    return this->entries.size();
+  }
+};
+
+inline auto get_layout_cache() -> tt::layout_cache & {
+  static tt::layout_cache cache;
+  return cache;
+}
+
+} // namespace runtime
+} // namespace tt
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <tt/core/memory.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace tt {
+inline namespace runtime {
+
+// offsets of buffers not aligned to anything coarser, e.g. row-major ones,
+// start on a cache line of their own
+inline constexpr std::size_t default_buffer_alignment = 64;
+
+// buffer of size bytes that is written at step first and last read at step
+// last of a sequence of operators
+struct buffer_lifetime {
+  std::size_t size;
+  std::size_t alignment = tt::default_buffer_alignment;
+  std::size_t first;
+  std::size_t last;
+};
+
+// offsets in bytes of buffers within an arena of size bytes whose start is
+// aligned to alignment
+struct memory_plan {
+  std::vector<std::size_t> offsets;
+  std::size_t size = 0;
+  std::size_t alignment = tt::default_buffer_alignment;
+};
+
+namespace detail {
+
+constexpr auto align_up(std::size_t offset, std::size_t alignment) noexcept
+    -> std::size_t {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+} // namespace detail
+
+// places buffers so that those live at the same step do not overlap and the
+// others reuse the same bytes: largest first, each at the lowest aligned
+// offset clear of the buffers already placed that it is live with, which
+// keeps the arena close to the peak of the bytes live at any step
+inline auto plan_memory(const std::vector<tt::buffer_lifetime> &buffers)
+    -> tt::memory_plan {
+  tt::memory_plan plan{std::vector<std::size_t>(buffers.size())};
+  std::vector<std::size_t> order(buffers.size());
+  std::vector<std::size_t> placed;
+
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::stable_sort(order.begin(), order.end(),
+                   [&](std::size_t lhs, std::size_t rhs) {
+                     return buffers[lhs].size > buffers[rhs].size;
+                   });
+
+  for (const auto index : order) {
+    const auto &buffer = buffers[index];
+    std::vector<std::pair<std::size_t, std::size_t>> taken;
+    std::size_t offset = 0;
+
+    assert(buffer.first <= buffer.last);
+
+    for (const auto other : placed) {
+      if (buffers[other].first <= buffer.last and
+          buffer.first <= buffers[other].last) {
+        taken.emplace_back(plan.offsets[other],
+                           plan.offsets[other] + buffers[other].size);
+      }
+    }
+
+    std::sort(taken.begin(), taken.end());
+
+    for (const auto &[begin, end] : taken) {
+      offset = detail::align_up(offset, buffer.alignment);
+
+      if (offset + buffer.size <= begin) {
+        break;
+      }
+
+      offset = std::max(offset, end);
+    }
+
+    offset = detail::align_up(offset, buffer.alignment);
+    plan.offsets[index] = offset;
+    plan.size = std::max(plan.size, offset + buffer.size);
+    plan.alignment = std::max(plan.alignment, buffer.alignment);
+    placed.push_back(index);
+  }
+
+  return plan;
+}
+
+// single buffer laid out by a tt::memory_plan, from which the buffers of the
+// plan are handed out as tensor data that keeps the arena alive
+class memory_arena {
+  std::shared_ptr<std::byte[]> buffer;
+  std::byte *base = nullptr;
+
+public:
+  memory_arena() = default;
+
+  // allocates once, with room to align the start of the plan
+  explicit memory_arena(const tt::memory_plan &plan)
+      : buffer(tt::make_shared_for_overwrite<std::byte[]>(plan.size +
+                                                          plan.alignment)) {
+    const auto address = reinterpret_cast<std::uintptr_t>(this->buffer.get());
+
+    this->base =
+        this->buffer.get() + (detail::align_up(address, plan.alignment) -
+                              address);
+  }
+
+  template <class T>
+  auto data(std::size_t offset) const -> std::shared_ptr<T[]> {
+    return {this->buffer, reinterpret_cast<T *>(this->base + offset)};
+  }
+};
+
+} // namespace runtime
+} // namespace tt
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <tt/core/tile.hpp>
+#include <tt/runtime/thread_pool.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace tt {
+inline namespace runtime {
+namespace detail {
+
+// a few chunks per thread leaves work to steal from threads that fall behind
+inline constexpr std::size_t chunks_per_thread = 4;
+
+inline auto chunk_size(std::size_t count, std::size_t grain,
+                       std::size_t threads) noexcept -> std::size_t {
+  if (threads <= 1) {
+    return count;
+  }
+
+  const auto chunks =
+      std::clamp<std::size_t>(count / std::max<std::size_t>(grain, 1), 1,
+                              threads * detail::chunks_per_thread);
+
+  return (count + chunks - 1) / chunks;
+}
+
+} // namespace detail
+
+// elements touched by one task below which splitting costs more than it saves
+inline constexpr std::size_t default_grain_size = std::size_t{1} << 14;
+
+// iterations per task when each iteration touches work elements
+constexpr auto grain_size(std::size_t work) noexcept -> std::size_t {
+  return std::max<std::size_t>(
+      tt::default_grain_size / std::max<std::size_t>(work, 1), 1);
+}
+
+// calls callback(first, last) on disjoint subranges that cover [begin, end),
+// each of at least grain iterations, on the threads of the shared pool
+template <class TCallback>
+auto parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+                  const TCallback &callback) -> void {
+  if (end <= begin) {
+    return;
+  }
+
+  const auto count = end - begin;
+
+  if (count <= grain) {
+    callback(begin, end);
+    return;
+  }
+
+  const auto pool = tt::get_thread_pool();
+  const auto chunk = detail::chunk_size(count, grain, pool->size());
+
+  if (chunk >= count) {
+    callback(begin, end);
+  } else {
+    pool->run(begin, end, chunk, callback);
+  }
+}
+
+// folds callback(first, last) over the same subranges as parallel_for, in
+// order, so the result only depends on the number of threads
+template <class T, class TCallback, class TCombine>
+auto parallel_reduce(std::size_t begin, std::size_t end, std::size_t grain,
+                     T init, const TCallback &callback,
+                     const TCombine &combine) -> T {
+  if (end <= begin) {
+    return init;
+  }
+
+  const auto count = end - begin;
+
+  if (count <= grain) {
+    return combine(init, callback(begin, end));
+  }
+
+  const auto pool = tt::get_thread_pool();
+  const auto chunk = detail::chunk_size(count, grain, pool->size());
+
+  if (chunk >= count) {
+    return combine(init, callback(begin, end));
+  }
+
+  std::vector<T> partials((count + chunk - 1) / chunk);
+
+  pool->run(begin, end, chunk, [&](std::size_t first, std::size_t last) {
+    partials[(first - begin) / chunk] = callback(first, last);
+  });
+
+  for (const auto &partial : partials) {
+    init = combine(init, partial);
+  }
+
+  return init;
+}
+
+// visits the tiles of a tiled tensor, splitting them in storage order across
+// the threads of the shared pool
+template <class TInput, class TCallback,
+          class = std::enable_if_t<tt::tiled<TInput>>>
+auto parallel_for_each_tile(const TInput &input,
+                            const TCallback &callback) -> void {
+  using tile_type = tt::tile_type_t<TInput>;
+
+  const auto range = tt::tiles(input);
+
+  tt::parallel_for(0, range.size(), tt::grain_size(tile_type::size()),
+                   [&](std::size_t first, std::size_t last) {
+                     range.for_each(first, last, callback);
+                   });
+}
+
+} // namespace runtime
+} // namespace tt
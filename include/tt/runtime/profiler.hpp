@@ -0,0 +1,330 @@
+#pragma once
+
+#include <tt/core/dtype.hpp>
+#include <tt/core/generator_accessor.hpp>
+#include <tt/core/layout.hpp>
+#include <tt/core/type_traits.hpp>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <magic_enum.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace tt {
+inline namespace runtime {
+
+struct tensor_description {
+  std::string dtype;
+  std::vector<std::size_t> shape;
+  std::string layout;
+};
+
+// one call of an operator; times are in nanoseconds since the profiler was
+// created
+struct profile_event {
+  std::string name;
+  // inputs followed by outputs
+  std::vector<tt::tensor_description> tensors;
+  // read from inputs and written to outputs
+  std::size_t bytes = 0;
+  std::int64_t start = 0;
+  std::int64_t duration = 0;
+  // numbered in the order threads first recorded an event
+  std::size_t thread = 0;
+};
+
+namespace detail {
+
+template <class T>
+auto dtype_name() -> std::string {
+  if constexpr (tt::has_dtype_v<T>) {
+    return std::string{magic_enum::enum_name(tt::value_v<tt::dtypes, T>)};
+  } else {
+    return "unknown";
+  }
+}
+
+template <class TLayout>
+auto layout_name() -> std::string {
+  if constexpr (std::is_same_v<TLayout, tt::RowMajor>) {
+    return "RowMajor";
+  } else if constexpr (std::is_same_v<TLayout, tt::ColMajor>) {
+    return "ColMajor";
+  } else if constexpr (std::is_same_v<TLayout, tt::Strided>) {
+    return "Strided";
+  } else if constexpr (TLayout::face_height == TLayout::tile_height and
+                       TLayout::face_width == TLayout::tile_width) {
+    return fmt::format("Tiled{}x{}", TLayout::tile_height,
+                       TLayout::tile_width);
+  } else {
+    return fmt::format("TiledFaces{}x{}", TLayout::tile_height,
+                       TLayout::tile_width);
+  }
+}
+
+template <class TTensor>
+auto describe(const TTensor &tensor) -> tt::tensor_description {
+  tt::tensor_description description{
+      detail::dtype_name<std::remove_cv_t<tt::element_type_t<TTensor>>>(),
+      std::vector<std::size_t>(TTensor::rank()),
+      detail::layout_name<tt::layout_type_t<TTensor>>(),
+  };
+
+  for (std::size_t r = 0; r < TTensor::rank(); ++r) {
+    description.shape[r] = tensor.extent(r);
+  }
+
+  return description;
+}
+
+// generated tensors compute their elements instead of reading memory
+template <class TTensor>
+auto bytes_of(const TTensor &tensor) noexcept -> std::size_t {
+  if constexpr (tt::generated<TTensor>) {
+    return 0;
+  } else {
+    return tensor.mapping().required_span_size() *
+           sizeof(tt::element_type_t<TTensor>);
+  }
+}
+
+// events recorded by one thread; the lock is only contended while the events
+// are collected
+struct profile_buffer {
+  std::mutex mutex;
+  std::vector<tt::profile_event> events;
+  std::size_t thread;
+
+  explicit profile_buffer(std::size_t thread) noexcept : thread(thread) {}
+};
+
+} // namespace detail
+
+// collects the events of every thread while enabled; operators check
+// enabled() before describing their tensors, so that profiling costs a
+// relaxed load per operator while disabled
+class profiler {
+  using clock = std::chrono::steady_clock;
+
+  std::atomic<bool> active{false};
+  std::mutex mutex;
+  std::vector<std::shared_ptr<detail::profile_buffer>> buffers;
+  clock::time_point epoch = clock::now();
+
+  auto buffer() -> detail::profile_buffer & {
+    static thread_local std::shared_ptr<detail::profile_buffer> current;
+
+    if (not current) {
+      const std::lock_guard lock{this->mutex};
+
+      current = std::make_shared<detail::profile_buffer>(this->buffers.size());
+      this->buffers.push_back(current);
+    }
+
+    return *current;
+  }
+
+public:
+  auto enabled() const noexcept -> bool {
+    return this->active.load(std::memory_order_relaxed);
+  }
+
+  auto enable() noexcept -> void {
+    this->active.store(true, std::memory_order_relaxed);
+  }
+
+  auto disable() noexcept -> void {
+    this->active.store(false, std::memory_order_relaxed);
+  }
+
+  auto now() const noexcept -> std::int64_t {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() -
+                                                                this->epoch)
+        .count();
+  }
+
+  auto record(tt::profile_event event) -> void {
+    auto &buffer = this->buffer();
+    const std::lock_guard lock{buffer.mutex};
+
+    event.thread = buffer.thread;
+    buffer.events.push_back(std::move(event));
+  }
+
+  // events of every thread in the order they started
+  auto events() -> std::vector<tt::profile_event> {
+    std::vector<tt::profile_event> events;
+    const std::lock_guard lock{this->mutex};
+
+    for (const auto &buffer : this->buffers) {
+      const std::lock_guard buffer_lock{buffer->mutex};
+
+      events.insert(events.end(), buffer->events.begin(),
+                    buffer->events.end());
+    }
+
+    std::stable_sort(events.begin(), events.end(),
+                     [](const auto &lhs, const auto &rhs) {
+                       return lhs.start < rhs.start;
+                     });
+
+    return events;
+  }
+
+  auto clear() -> void {
+    const std::lock_guard lock{this->mutex};
+
+    for (const auto &buffer : this->buffers) {
+      const std::lock_guard buffer_lock{buffer->mutex};
+
+      buffer->events.clear();
+    }
+  }
+};
+
+inline auto get_profiler() -> tt::profiler & {
+  static tt::profiler profiler;
+  return profiler;
+}
+
+// records an event for the operator call that spans its lifetime, if the
+// profiler is enabled when it is created
+class profile_scope {
+  std::optional<tt::profile_event> event;
+
+  template <class TTensor>
+  auto add(const TTensor &tensor) -> void {
+    this->event->tensors.push_back(detail::describe(tensor));
+    this->event->bytes += detail::bytes_of(tensor);
+  }
+
+public:
+  template <class... TInputs>
+  explicit profile_scope(const char *name, const TInputs &...inputs) {
+    auto &profiler = tt::get_profiler();
+
+    if (not profiler.enabled()) {
+      return;
+    }
+
+    this->event.emplace();
+    this->event->name = name;
+    (this->add(inputs), ...);
+    this->event->start = profiler.now();
+  }
+
+  profile_scope(const profile_scope &) = delete;
+
+  auto operator=(const profile_scope &) -> profile_scope & = delete;
+
+  ~profile_scope() {
+    if (this->event) {
+      auto &profiler = tt::get_profiler();
+
+      this->event->duration = profiler.now() - this->event->start;
+      profiler.record(std::move(*this->event));
+    }
+  }
+
+  // adds a tensor the operator wrote, once it exists
+  template <class TOutput>
+  auto output(const TOutput &tensor) -> void {
+    if (this->event) {
+      this->add(tensor);
+    }
+  }
+};
+
+// calls, time and throughput per operator, slowest first
+inline auto profile_summary(const std::vector<tt::profile_event> &events)
+    -> std::string {
+  struct totals {
+    std::size_t calls = 0;
+    std::int64_t duration = 0;
+    std::int64_t max_duration = 0;
+    std::size_t bytes = 0;
+  };
+
+  std::map<std::string, totals> by_name;
+
+  for (const auto &event : events) {
+    auto &entry = by_name[event.name];
+
+    entry.calls += 1;
+    entry.duration += event.duration;
+    entry.max_duration = std::max(entry.max_duration, event.duration);
+    entry.bytes += event.bytes;
+  }
+
+  std::vector<std::pair<std::string, totals>> rows(by_name.begin(),
+                                                   by_name.end());
+
+  std::stable_sort(rows.begin(), rows.end(),
+                   [](const auto &lhs, const auto &rhs) {
+                     return lhs.second.duration > rhs.second.duration;
+                   });
+
+  auto table = fmt::format("{:<16} {:>8} {:>12} {:>12} {:>12} {:>10}\n",
+                           "operator", "calls", "total (ms)", "mean (us)",
+                           "max (us)", "GB/s");
+
+  for (const auto &[name, entry] : rows) {
+    const auto seconds = 1e-9 * static_cast<double>(entry.duration);
+
+    table += fmt::format(
+        "{:<16} {:>8} {:>12.3f} {:>12.3f} {:>12.3f} {:>10.2f}\n", name,
+        entry.calls, 1e3 * seconds,
+        1e-3 * static_cast<double>(entry.duration) /
+            static_cast<double>(entry.calls),
+        1e-3 * static_cast<double>(entry.max_duration),
+        seconds > 0 ? 1e-9 * static_cast<double>(entry.bytes) / seconds : 0.0);
+  }
+
+  return table;
+}
+
+// trace event format read by chrome://tracing and perfetto, with one complete
+// event per operator call
+inline auto chrome_trace(const std::vector<tt::profile_event> &events)
+    -> std::string {
+  std::string trace = "{\"traceEvents\":[";
+
+  for (std::size_t index = 0; index < events.size(); ++index) {
+    const auto &event = events[index];
+    std::vector<std::string> tensors;
+
+    for (const auto &tensor : event.tensors) {
+      tensors.push_back(fmt::format("\"{}[{}] {}\"", tensor.dtype,
+                                    fmt::join(tensor.shape, ","),
+                                    tensor.layout));
+    }
+
+    trace += fmt::format(
+        "{}{{\"name\":\"{}\",\"cat\":\"operator\",\"ph\":\"X\","
+        "\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":0,\"tid\":{},"
+        "\"args\":{{\"tensors\":[{}],\"bytes\":{}}}}}",
+        index == 0 ? "" : ",", event.name,
+        1e-3 * static_cast<double>(event.start),
+        1e-3 * static_cast<double>(event.duration), event.thread,
+        fmt::join(tensors, ","), event.bytes);
+  }
+
+  trace += "],\"displayTimeUnit\":\"ns\"}";
+
+  return trace;
+}
+
+} // namespace runtime
+} // namespace tt
@@ -0,0 +1,449 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace tt {
+inline namespace runtime {
+namespace detail {
+
+// parses a sysfs cpu list such as "0-3,8,10-11"
+inline auto parse_cpu_list(const std::string &list) -> std::vector<unsigned> {
+  std::vector<unsigned> cpus;
+  const char *first = list.c_str();
+
+  while (*first != '\0') {
+    char *last = nullptr;
+    const auto begin = std::strtoul(first, &last, 10);
+
+    if (last == first) {
+      break;
+    }
+
+    auto end = begin;
+
+    if (*last == '-') {
+      first = last + 1;
+      end = std::strtoul(first, &last, 10);
+    }
+
+    for (auto cpu = begin; cpu <= end; ++cpu) {
+      cpus.push_back(static_cast<unsigned>(cpu));
+    }
+
+    first = *last == ',' ? last + 1 : last;
+  }
+
+  return cpus;
+}
+
+// cpus the process may run on, grouped by numa node so that consecutive
+// workers share a node and its memory
+inline auto cpus_by_node() -> std::vector<unsigned> {
+  std::vector<unsigned> cpus;
+
+#if defined(__linux__)
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+
+  const auto has_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+  const auto is_allowed = [&](unsigned cpu) {
+    return not has_mask or (cpu < CPU_SETSIZE and CPU_ISSET(cpu, &allowed));
+  };
+
+  for (unsigned node = 0;; ++node) {
+    std::ifstream file{"/sys/devices/system/node/node" + std::to_string(node) +
+                       "/cpulist"};
+    std::string list;
+
+    if (not std::getline(file, list)) {
+      break;
+    }
+
+    for (const auto cpu : detail::parse_cpu_list(list)) {
+      if (is_allowed(cpu)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+
+  if (cpus.empty() and has_mask) {
+    for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &allowed)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+
+  return cpus;
+}
+
+inline auto pin_current_thread(unsigned cpu) noexcept -> bool {
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  static_cast<void>(cpu);
+  return false;
+#endif
+}
+
+inline auto getenv_size(const char *name) -> std::optional<std::size_t> {
+  const char *value = std::getenv(name);
+
+  if (value == nullptr or *value == '\0') {
+    return std::nullopt;
+  }
+
+  char *last = nullptr;
+  const auto result = std::strtoull(value, &last, 10);
+
+  if (*last != '\0') {
+    return std::nullopt;
+  }
+
+  return static_cast<std::size_t>(result);
+}
+
+// iterations of one call to thread_pool::run, shared by all of its tasks
+struct job {
+  using invoke_type = void (*)(const void *callback, std::size_t begin,
+                               std::size_t end);
+
+  invoke_type invoke;
+  const void *callback;
+  std::atomic<std::size_t> remaining;
+  std::atomic<bool> failed{false};
+  std::exception_ptr exception;
+  // set by the last task, for the submitting thread to sleep on once every
+  // task has been taken
+  std::mutex mutex;
+  std::condition_variable done;
+  bool finished = false;
+
+  job(invoke_type invoke, const void *callback, std::size_t count) noexcept
+      : invoke(invoke), callback(callback), remaining(count),
+        finished(count == 0) {}
+
+  auto run(std::size_t begin, std::size_t end) noexcept -> void {
+    if (not this->failed.load(std::memory_order_relaxed)) {
+      try {
+        this->invoke(this->callback, begin, end);
+      } catch (...) {
+        if (not this->failed.exchange(true)) {
+          this->exception = std::current_exception();
+        }
+      }
+    }
+
+    if (this->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      // notified under the lock, since the submitting thread destroys the
+      // job as soon as it sees finished
+      const std::lock_guard lock{this->mutex};
+
+      this->finished = true;
+      this->done.notify_all();
+    }
+  }
+};
+
+struct task {
+  detail::job *owner;
+  std::size_t begin;
+  std::size_t end;
+};
+
+struct task_queue {
+  std::mutex mutex;
+  std::deque<detail::task> tasks;
+};
+
+} // namespace detail
+
+struct thread_pool_options {
+  // threads that run tasks, counting the thread that submits them
+  std::size_t num_threads = 1;
+  // pins each worker to one cpu, filling numa nodes in order
+  bool pin_threads = false;
+
+  // TT_NUM_THREADS defaults to every cpu the process may run on, and
+  // TT_PIN_THREADS=1 enables pinning
+  static auto from_env() -> thread_pool_options {
+    const auto cpus = detail::cpus_by_node();
+    const std::size_t available =
+        cpus.empty() ? std::max(std::thread::hardware_concurrency(), 1u)
+                     : cpus.size();
+
+    return {
+        std::max<std::size_t>(
+            detail::getenv_size("TT_NUM_THREADS").value_or(available), 1),
+        detail::getenv_size("TT_PIN_THREADS").value_or(0) != 0,
+    };
+  }
+};
+
+// work-stealing pool: each thread owns a queue of tasks, pops its own tasks
+// from the back and steals from the front of the others when it runs out; the
+// thread that submits a job runs tasks too until the job completes, so nested
+// jobs never wait on a thread that is waiting on them
+class thread_pool {
+  std::vector<std::unique_ptr<detail::task_queue>> queues;
+  std::vector<std::thread> workers;
+  std::mutex sleep_mutex;
+  std::condition_variable wake;
+  std::atomic<std::size_t> queued{0};
+  bool stopping = false;
+
+  // queue of the calling thread, where queue 0 is shared by every thread that
+  // does not belong to this pool
+  static inline thread_local const thread_pool *current_pool = nullptr;
+  static inline thread_local std::size_t current_index = 0;
+
+  auto index_of_current_thread() const noexcept -> std::size_t {
+    return current_pool == this ? current_index : 0;
+  }
+
+  auto pop(std::size_t index) -> std::optional<detail::task> {
+    const auto size = this->queues.size();
+
+    for (std::size_t offset = 0; offset < size; ++offset) {
+      auto &queue = *this->queues[(index + offset) % size];
+      const std::lock_guard lock{queue.mutex};
+
+      if (queue.tasks.empty()) {
+        continue;
+      }
+
+      detail::task task{};
+
+      if (offset == 0) {
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+      } else {
+        task = queue.tasks.front();
+        queue.tasks.pop_front();
+      }
+
+      this->queued.fetch_sub(1, std::memory_order_relaxed);
+      return task;
+    }
+
+    return std::nullopt;
+  }
+
+  auto try_run_one(std::size_t index) -> bool {
+    const auto task = this->pop(index);
+
+    if (not task) {
+      return false;
+    }
+
+    task->owner->run(task->begin, task->end);
+    return true;
+  }
+
+  auto work(std::size_t index, std::optional<unsigned> cpu) -> void {
+    current_pool = this;
+    current_index = index;
+
+    if (cpu) {
+      detail::pin_current_thread(*cpu);
+    }
+
+    for (;;) {
+      if (this->try_run_one(index)) {
+        continue;
+      }
+
+      std::unique_lock lock{this->sleep_mutex};
+
+      this->wake.wait(lock, [&] {
+        return this->stopping or
+               this->queued.load(std::memory_order_relaxed) > 0;
+      });
+
+      if (this->stopping and
+          this->queued.load(std::memory_order_relaxed) == 0) {
+        return;
+      }
+    }
+  }
+
+public:
+  explicit thread_pool(const thread_pool_options &options) {
+    const auto size = std::max<std::size_t>(options.num_threads, 1);
+    const auto cpus =
+        options.pin_threads ? detail::cpus_by_node() : std::vector<unsigned>{};
+
+    for (std::size_t index = 0; index < size; ++index) {
+      this->queues.push_back(std::make_unique<detail::task_queue>());
+    }
+
+    for (std::size_t index = 1; index < size; ++index) {
+      const auto cpu = cpus.empty()
+                           ? std::nullopt
+                           : std::optional{cpus[index % cpus.size()]};
+
+      this->workers.emplace_back(
+          [this, index, cpu] { this->work(index, cpu); });
+    }
+  }
+
+  thread_pool(const thread_pool &) = delete;
+
+  auto operator=(const thread_pool &) -> thread_pool & = delete;
+
+  ~thread_pool() {
+    {
+      const std::lock_guard lock{this->sleep_mutex};
+      this->stopping = true;
+    }
+
+    this->wake.notify_all();
+
+    for (auto &worker : this->workers) {
+      worker.join();
+    }
+  }
+
+  auto size() const noexcept -> std::size_t { return this->queues.size(); }
+
+  // calls callback(first, last) for consecutive chunks of [begin, end) and
+  // returns once all of them have, rethrowing the first exception thrown
+  template <class TCallback>
+  auto run(std::size_t begin, std::size_t end, std::size_t chunk,
+           const TCallback &callback) -> void {
+    const auto count = (end - begin + chunk - 1) / chunk;
+    const auto index = this->index_of_current_thread();
+    const auto size = this->queues.size();
+
+    detail::job job{
+        [](const void *callback, std::size_t first, std::size_t last) {
+          (*static_cast<const TCallback *>(callback))(first, last);
+        },
+        &callback,
+        count,
+    };
+
+    // counted before they are pushed, so that a worker already awake that
+    // takes one never counts queued below zero
+    this->queued.fetch_add(count, std::memory_order_relaxed);
+
+    for (std::size_t offset = 0; offset < count; ++offset) {
+      const auto first = begin + offset * chunk;
+      const auto last = std::min(end, first + chunk);
+      auto &queue = *this->queues[(index + offset) % size];
+      const std::lock_guard lock{queue.mutex};
+
+      queue.tasks.push_back({&job, first, last});
+    }
+
+    {
+      // orders the update of queued before any worker checks it to sleep
+      const std::lock_guard lock{this->sleep_mutex};
+    }
+
+    this->wake.notify_all();
+
+    // tasks are only ever taken from the queues, so once none is left to run
+    // the rest of the job is running on other threads
+    while (job.remaining.load(std::memory_order_acquire) > 0 and
+           this->try_run_one(index)) {
+    }
+
+    {
+      std::unique_lock lock{job.mutex};
+
+      job.done.wait(lock, [&] { return job.finished; });
+    }
+
+    if (job.exception) {
+      std::rethrow_exception(job.exception);
+    }
+  }
+};
+
+namespace detail {
+
+struct shared_thread_pool {
+  std::mutex mutex;
+  tt::thread_pool_options options = tt::thread_pool_options::from_env();
+  std::shared_ptr<tt::thread_pool> pool;
+};
+
+inline auto get_shared_thread_pool() -> shared_thread_pool & {
+  static shared_thread_pool state;
+  return state;
+}
+
+} // namespace detail
+
+// pool shared by every operator in the process, created on first use; jobs
+// already running keep the pool they started on alive
+inline auto get_thread_pool() -> std::shared_ptr<tt::thread_pool> {
+  auto &state = detail::get_shared_thread_pool();
+  const std::lock_guard lock{state.mutex};
+
+  if (not state.pool) {
+    state.pool = std::make_shared<tt::thread_pool>(state.options);
+  }
+
+  return state.pool;
+}
+
+inline auto get_thread_pool_options() -> tt::thread_pool_options {
+  auto &state = detail::get_shared_thread_pool();
+  const std::lock_guard lock{state.mutex};
+
+  return state.options;
+}
+
+inline auto set_thread_pool_options(const tt::thread_pool_options &options)
+    -> void {
+  auto &state = detail::get_shared_thread_pool();
+  // joined outside the lock, once no running job holds it
+  std::shared_ptr<tt::thread_pool> previous;
+
+  {
+    const std::lock_guard lock{state.mutex};
+
+    state.options = options;
+    state.options.num_threads = std::max<std::size_t>(options.num_threads, 1);
+    previous = std::exchange(state.pool, nullptr);
+  }
+}
+
+inline auto get_num_threads() -> std::size_t {
+  return tt::get_thread_pool_options().num_threads;
+}
+
+inline auto set_num_threads(std::size_t num_threads) -> void {
+  auto options = tt::get_thread_pool_options();
+
+  options.num_threads = num_threads;
+  tt::set_thread_pool_options(options);
+}
+
+} // namespace runtime
+} // namespace tt
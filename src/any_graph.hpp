@@ -0,0 +1,411 @@
+#pragma once
+
+#include "any_tensor.hpp"
+#include "any_views.hpp"
+
+#include <tt/operators/transpose.hpp>
+#include <tt/runtime/memory_planner.hpp>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <magic_enum.hpp>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
+
+using any_view = std::variant<any_to_layout_view, any_reshape_view,
+                              any_permute_view, tt::transpose_view>;
+
+// a view of the plan and the layout and extents of the tensor it applies to
+struct planned_view {
+  any_view view;
+  std::size_t layout;
+  std::vector<std::size_t> extents;
+};
+
+template <class TView>
+auto last_view(std::vector<planned_view> &planned) -> TView * {
+  return planned.empty() ? nullptr : std::get_if<TView>(&planned.back().view);
+}
+
+inline auto is_axes_permutation(const std::vector<std::size_t> &axes,
+                                std::size_t rank) -> bool {
+  std::vector<bool> seen(rank);
+
+  if (axes.size() != rank) {
+    return false;
+  }
+
+  for (const auto axis : axes) {
+    if (axis >= rank or seen[axis]) {
+      return false;
+    }
+
+    seen[axis] = true;
+  }
+
+  return true;
+}
+
+// rewrites views piped into a tensor of the layout and extents into views
+// that give the same elements with fewer passes over them: a conversion that
+// is converted again, or into the layout the tensor has, is dropped; a
+// conversion between strided layouts is absorbed by a permute after it, which
+// views either; consecutive reshapes and permutes are folded into one
+inline auto plan_views(const std::vector<any_view> &views, std::size_t layout,
+                       std::vector<std::size_t> extents)
+    -> std::vector<planned_view> {
+  constexpr auto strided = layout_index_v<tt::Strided>;
+
+  std::vector<planned_view> planned;
+
+  // continues from the tensor the previous view was applied to
+  const auto pop = [&] {
+    layout = planned.back().layout;
+    extents = std::move(planned.back().extents);
+    planned.pop_back();
+  };
+
+  for (auto view : views) {
+    if (std::holds_alternative<tt::transpose_view>(view)) {
+      std::vector<std::size_t> axes(extents.size());
+
+      for (std::size_t r = 0; r < axes.size(); ++r) {
+        axes[r] = axes.size() - 1 - r;
+      }
+
+      view = any_permute_view{std::move(axes)};
+    }
+
+    if (const auto to = std::get_if<any_to_layout_view>(&view)) {
+      const auto from = last_view<any_to_layout_view>(planned);
+
+      if (from and not from->out) {
+        pop();
+      }
+
+      if (to->layout == layout and not to->out) {
+        continue;
+      }
+
+      planned.push_back({view, layout, extents});
+      layout = to->layout;
+    } else if (const auto to = std::get_if<any_reshape_view>(&view)) {
+      // reshapes of strided views throw, which is left to the plan
+      if (layout != strided and
+          last_view<any_reshape_view>(planned)) {
+        pop();
+      }
+
+      if (layout != strided and to->extents == extents) {
+        continue;
+      }
+
+      planned.push_back({view, layout, extents});
+      extents = to->extents;
+    } else if (const auto to = std::get_if<any_permute_view>(&view)) {
+      // invalid axes throw, which is left to the plan
+      const auto valid = is_axes_permutation(to->axes, extents.size());
+
+      for (auto folded = valid; folded;) {
+        const auto from_permute = last_view<any_permute_view>(planned);
+        const auto from_layout = last_view<any_to_layout_view>(planned);
+
+        folded = false;
+
+        if (from_permute and
+            is_axes_permutation(from_permute->axes, extents.size())) {
+          for (auto &axis : to->axes) {
+            axis = from_permute->axes[axis];
+          }
+
+          pop();
+          folded = true;
+        } else if (from_layout and not from_layout->out and
+                   is_strided_layout(from_layout->layout) and
+                   is_strided_layout(planned.back().layout)) {
+          pop();
+          folded = true;
+        }
+      }
+
+      planned.push_back({view, layout, extents});
+
+      if (valid) {
+        const auto input_extents = extents;
+
+        for (std::size_t r = 0; r < extents.size(); ++r) {
+          extents[r] = input_extents[to->axes[r]];
+        }
+      }
+
+      layout = strided;
+    }
+  }
+
+  return planned;
+}
+
+// views to replay and where in an arena the conversions among them write
+struct graph_plan {
+  std::vector<any_view> views;
+  std::vector<std::optional<std::size_t>> offsets;
+  tt::memory_plan memory;
+};
+
+// bytes of a buffer of the layout and extents and the alignment of its start,
+// which is a whole tile for tiled layouts
+inline auto buffer_lifetime_of(std::size_t element_size, std::size_t layout,
+                               const std::vector<std::size_t> &extents,
+                               std::size_t first, std::size_t last)
+    -> tt::buffer_lifetime {
+  tt::buffer_lifetime buffer{
+      required_span_size(layout, extents) * element_size,
+      tt::default_buffer_alignment,
+      first,
+      last,
+  };
+
+  if (not is_strided_layout(layout)) {
+    visit_layout<blocked_layout_types>(layout, [&](auto identity) {
+      using layout_type = typename decltype(identity)::type;
+
+      buffer.alignment =
+          std::max(buffer.alignment, layout_type::tile_size * element_size);
+    });
+  }
+
+  return buffer;
+}
+
+// plans views piped into a tensor of the dtype, layout and extents: rewrites
+// them with plan_views(), splits conversions that to_layout() would make
+// through row-major into two, and places the buffers of conversions that a
+// later conversion reads in one arena, reused between buffers that are not
+// live at the same time; the last conversion allocates the result instead,
+// which outlives the arena
+inline auto plan_graph(const std::vector<any_view> &views, tt::dtype dtype,
+                       std::size_t layout,
+                       const std::vector<std::size_t> &extents)
+    -> graph_plan {
+  constexpr auto row_major = layout_index_v<tt::RowMajor>;
+
+  const auto element_size = visit_dtype(dtype, [](auto element) {
+    return sizeof(typename decltype(element)::type);
+  });
+
+  std::vector<planned_view> planned;
+
+  for (auto &entry : plan_views(views, layout, extents)) {
+    if (const auto to = std::get_if<any_to_layout_view>(&entry.view)) {
+      if (converts_through_row_major(entry.layout, to->layout)) {
+        planned.push_back({any_to_layout_view{row_major, std::nullopt},
+                           entry.layout, entry.extents});
+        entry.layout = row_major;
+      }
+    }
+
+    planned.push_back(std::move(entry));
+  }
+
+  graph_plan plan;
+  std::vector<tt::buffer_lifetime> buffers;
+  std::vector<std::size_t> writers;
+  // conversion whose buffer the next conversion reads, if it is not out
+  std::optional<std::size_t> writer;
+
+  for (std::size_t step = 0; step < planned.size(); ++step) {
+    const auto to = std::get_if<any_to_layout_view>(&planned[step].view);
+
+    if (not to) {
+      continue;
+    }
+
+    if (writer) {
+      const auto &written = std::get<any_to_layout_view>(planned[*writer].view);
+
+      buffers.push_back(buffer_lifetime_of(element_size, written.layout,
+                                           planned[*writer].extents, *writer,
+                                           step));
+      writers.push_back(*writer);
+    }
+
+    writer = to->out ? std::nullopt : std::optional{step};
+  }
+
+  plan.offsets.resize(planned.size());
+  plan.memory = tt::plan_memory(buffers);
+
+  for (std::size_t index = 0; index < writers.size(); ++index) {
+    plan.offsets[writers[index]] = plan.memory.offsets[index];
+  }
+
+  for (auto &entry : planned) {
+    plan.views.push_back(std::move(entry.view));
+  }
+
+  return plan;
+}
+
+// graphs keep the plans of this many dtypes, layouts and extents of inputs,
+// dropping the least recently used one for the next
+inline constexpr std::size_t max_graph_plans = 16;
+
+// views captured by piping them into each other, e.g.
+// tt.reshape(4, 8) | tt.to_tiled() | tt.reshape(2, 2, 8), which a tensor piped
+// into the graph replays. Only views are captured, not operators such as
+// arange or matmul, so nothing is fused into the kernels of the operators that
+// produce or consume the tensor; a replay saves the passes and allocations the
+// views would make one at a time. The views are planned once per dtype, layout
+// and extents of the tensors they are applied to, and the plan is kept for the
+// next tensor like them, up to max_graph_plans; a replay allocates the
+// arena of its intermediates and the result. The result has the elements the
+// views would give one at a time, but may share the buffer of the input where
+// they would have copied it.
+class any_graph {
+  using plan_key = std::tuple<tt::dtype, std::size_t, std::vector<std::size_t>>;
+
+  // plans most recently used first, found through the map
+  struct plans {
+    std::mutex mutex;
+    std::list<std::pair<plan_key, std::shared_ptr<const graph_plan>>> recent;
+    std::map<plan_key, decltype(recent)::iterator> entries;
+  };
+
+  std::vector<any_view> views;
+  // shared by copies of the graph, which capture the same views
+  std::shared_ptr<plans> cache = std::make_shared<plans>();
+
+public:
+  any_graph() = default;
+
+  explicit any_graph(std::vector<any_view> views) : views(std::move(views)) {}
+
+  auto size() const noexcept -> std::size_t { return this->views.size(); }
+
+  auto captured() const noexcept -> const std::vector<any_view> & {
+    return this->views;
+  }
+
+  // shared, so that a plan dropped by another thread outlives its replay
+  auto plan(const any_tensor &input) const
+      -> std::shared_ptr<const graph_plan> {
+    auto key = plan_key{input.dtype, input.layout, input.extents};
+    auto &cache = *this->cache;
+    const std::lock_guard lock{cache.mutex};
+
+    if (const auto entry = cache.entries.find(key);
+        entry != cache.entries.end()) {
+      cache.recent.splice(cache.recent.begin(), cache.recent, entry->second);
+
+      return entry->second->second;
+    }
+
+    if (cache.entries.size() == max_graph_plans) {
+      cache.entries.erase(cache.recent.back().first);
+      cache.recent.pop_back();
+    }
+
+    auto plan = std::make_shared<const graph_plan>(plan_graph(
+        this->views, input.dtype, input.layout, input.extents));
+
+    cache.recent.emplace_front(key, plan);
+    cache.entries.emplace(std::move(key), cache.recent.begin());
+
+    return plan;
+  }
+
+  auto then(any_view view) const -> any_graph {
+    auto views = this->views;
+
+    views.push_back(std::move(view));
+
+    return any_graph{std::move(views)};
+  }
+};
+
+// tensor of the layout and extents in the buffer at offset in the arena
+inline auto arena_tensor(const tt::memory_arena &arena, std::size_t offset,
+                         tt::dtype dtype, std::size_t layout,
+                         const std::vector<std::size_t> &extents)
+    -> any_tensor {
+  std::vector<std::size_t> strides;
+
+  if (layout == layout_index_v<tt::RowMajor>) {
+    strides = row_major_strides(extents);
+  } else if (layout == layout_index_v<tt::ColMajor>) {
+    strides = col_major_strides(extents);
+  }
+
+  return {dtype, layout, arena.data<std::byte>(offset), extents, strides};
+}
+
+inline auto operator|(const any_tensor &input, const any_graph &graph)
+    -> any_tensor {
+  const auto plan = graph.plan(input);
+  const auto arena = plan->memory.size > 0 ? tt::memory_arena{plan->memory}
+                                           : tt::memory_arena{};
+  auto output = input;
+
+  for (std::size_t step = 0; step < plan->views.size(); ++step) {
+    const auto &view = plan->views[step];
+
+    if (const auto offset = plan->offsets[step]) {
+      const auto layout = std::get<any_to_layout_view>(view).layout;
+
+      output = to_layout_into(output, arena_tensor(arena, *offset, input.dtype,
+                                                   layout, output.extents));
+    } else {
+      output =
+          std::visit([&](const auto &view) { return output | view; }, view);
+    }
+  }
+
+  return output;
+}
+
+inline auto format_view(const any_view &view) -> std::string {
+  if (const auto to = std::get_if<any_to_layout_view>(&view)) {
+    const auto name = visit_layout(to->layout, [](auto identity) {
+      using layout_type = typename decltype(identity)::type;
+
+      if constexpr (mp::mp_contains<tiled_layout_types, layout_type>::value) {
+        return fmt::format("Tiled{}x{}", layout_type::tile_height,
+                           layout_type::tile_width);
+      } else {
+        return std::string{
+            magic_enum::enum_name(tt::value_v<tt::layouts, layout_type>)};
+      }
+    });
+
+    return fmt::format("to_layout({}{})", name, to->out ? ", out" : "");
+  }
+
+  if (const auto to = std::get_if<any_reshape_view>(&view)) {
+    return fmt::format("reshape({})", fmt::join(to->extents, ", "));
+  }
+
+  if (const auto to = std::get_if<any_permute_view>(&view)) {
+    return fmt::format("permute({})", fmt::join(to->axes, ", "));
+  }
+
+  return "transpose()";
+}
+
+inline auto format_graph(const std::vector<any_view> &views) -> std::string {
+  std::vector<std::string> names;
+
+  for (const auto &view : views) {
+    names.push_back(format_view(view));
+  }
+
+  return fmt::format("Graph({})", fmt::join(names, " | "));
+}
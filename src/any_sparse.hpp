@@ -0,0 +1,160 @@
+#pragma once
+
+#include "any_tensor.hpp"
+
+#include <tt/core/sparse.hpp>
+#include <tt/operators/matmul.hpp>
+#include <tt/operators/to_sparse.hpp>
+
+#include <fmt/format.h>
+#include <magic_enum.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// sparse matrices whose dtype is only known at runtime, owning the buffers of
+// a tt::csr_matrix or tt::coo_matrix
+struct any_csr {
+  tt::dtype dtype;
+  std::size_t rows;
+  std::size_t cols;
+  std::shared_ptr<std::size_t[]> row_offsets;
+  std::shared_ptr<std::size_t[]> columns;
+  std::shared_ptr<void> values;
+
+  auto nnz() const noexcept -> std::size_t { return row_offsets[rows]; }
+};
+
+struct any_coo {
+  tt::dtype dtype;
+  std::size_t rows;
+  std::size_t cols;
+  std::size_t count;
+  std::shared_ptr<std::size_t[]> row_indices;
+  std::shared_ptr<std::size_t[]> columns;
+  std::shared_ptr<void> values;
+
+  auto nnz() const noexcept -> std::size_t { return count; }
+};
+
+template <class T>
+auto from_sparse(const tt::csr_matrix<T> &input) -> any_csr {
+  return {
+      tt::value_v<tt::dtypes, T>, input.extent(0), input.extent(1),
+      input.row_offsets(),        input.columns(), input.values(),
+  };
+}
+
+template <class T>
+auto from_sparse(const tt::coo_matrix<T> &input) -> any_coo {
+  return {
+      tt::value_v<tt::dtypes, T>, input.extent(0), input.extent(1),
+      input.nnz(),                input.rows(),    input.columns(),
+      input.values(),
+  };
+}
+
+template <class T>
+auto as_csr(const any_csr &input) -> tt::csr_matrix<T> {
+  return {tt::dims<2>{input.rows, input.cols}, input.row_offsets,
+          input.columns,
+          std::shared_ptr<T[]>{input.values,
+                               static_cast<T *>(input.values.get())}};
+}
+
+template <class T>
+auto as_coo(const any_coo &input) -> tt::coo_matrix<T> {
+  return {tt::dims<2>{input.rows, input.cols}, input.count, input.row_indices,
+          input.columns,
+          std::shared_ptr<T[]>{input.values,
+                               static_cast<T *>(input.values.get())}};
+}
+
+inline auto to_csr(const any_tensor &input) -> any_csr {
+  if (input.rank() != 2) {
+    throw std::invalid_argument(
+        fmt::format("expected a matrix; got a tensor of rank {}",
+                    input.rank()));
+  }
+
+  const auto strided = as_dense_strided(input);
+
+  return visit_dtype(input.dtype, [&](auto element) {
+    using element_type = typename decltype(element)::type;
+
+    return from_sparse(as_strided<element_type, 2>(strided) | tt::to_csr());
+  });
+}
+
+inline auto to_coo(const any_csr &input) -> any_coo {
+  return visit_dtype(input.dtype, [&](auto element) {
+    using element_type = typename decltype(element)::type;
+
+    return from_sparse(as_csr<element_type>(input) | tt::to_coo());
+  });
+}
+
+inline auto to_csr(const any_coo &input) -> any_csr {
+  return visit_dtype(input.dtype, [&](auto element) {
+    using element_type = typename decltype(element)::type;
+
+    return from_sparse(as_coo<element_type>(input) | tt::to_csr());
+  });
+}
+
+inline auto to_layout(const any_csr &input, std::size_t layout)
+    -> any_tensor {
+  const auto dense = visit_dtype(input.dtype, [&](auto element) {
+    using element_type = typename decltype(element)::type;
+
+    return from_tensor(as_csr<element_type>(input) | tt::to_row_major());
+  });
+
+  return layout == dense.layout ? dense : to_layout(dense, layout);
+}
+
+// sparse-dense product of a matrix or vector of the same dtype
+inline auto matmul(const any_csr &lhs, const any_tensor &rhs) -> any_tensor {
+  if (rhs.rank() != 1 and rhs.rank() != 2) {
+    throw std::invalid_argument(fmt::format(
+        "expected a vector or a matrix; got a tensor of rank {}",
+        rhs.rank()));
+  }
+
+  if (rhs.extents[0] != lhs.cols) {
+    throw std::invalid_argument(
+        fmt::format("cannot multiply a matrix of {} columns by {} rows",
+                    lhs.cols, rhs.extents[0]));
+  }
+
+  if (rhs.dtype != lhs.dtype) {
+    throw std::invalid_argument(
+        fmt::format("expected a tensor of dtype {}; got {}",
+                    magic_enum::enum_name(lhs.dtype),
+                    magic_enum::enum_name(rhs.dtype)));
+  }
+
+  const auto strided = as_dense_strided(rhs);
+
+  return visit_dtype(lhs.dtype, [&](auto element) {
+    using element_type = typename decltype(element)::type;
+
+    const auto sparse = as_csr<element_type>(lhs);
+
+    if (strided.rank() == 1) {
+      return from_tensor(
+          tt::matmul(sparse, as_strided<element_type, 1>(strided)));
+    }
+
+    return from_tensor(
+        tt::matmul(sparse, as_strided<element_type, 2>(strided)));
+  });
+}
+
+template <class TSparse>
+auto format_sparse(const char *name, const TSparse &input) -> std::string {
+  return fmt::format("{}(shape=({}, {}), nnz={}, dtype={})", name,
+                     input.rows, input.cols, input.nnz(),
+                     magic_enum::enum_name(input.dtype));
+}
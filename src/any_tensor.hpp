@@ -0,0 +1,719 @@
+#pragma once
+
+#include <tt/core/dtype.hpp>
+#include <tt/core/float.hpp>
+#include <tt/core/format.hpp>
+#include <tt/core/int.hpp>
+#include <tt/core/layout.hpp>
+#include <tt/core/tensor.hpp>
+#include <tt/operators/matmul.hpp>
+#include <tt/operators/to_layout.hpp>
+#include <tt/operators/to_layout_inplace.hpp>
+#include <tt/runtime/layout_cache.hpp>
+
+#include <boost/mp11.hpp>
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+#include <magic_enum.hpp>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mp = boost::mp11;
+
+// in the order of tt::dtype
+using element_types =
+    mp::mp_list<tt::Float32, tt::Float64, tt::BFloat16, tt::UInt8, tt::Int8,
+                tt::Int16, tt::Int32, tt::Int64, tt::Bool>;
+using tiled_layout_types =
+    mp::mp_list<tt::Tiled, tt::layout_right_tiled<8>,
+                tt::layout_right_tiled<16>, tt::layout_right_tiled<32>>;
+// layouts with a stride per extent, of which only the first two own a buffer
+using strided_layout_types =
+    mp::mp_list<tt::RowMajor, tt::ColMajor, tt::Strided>;
+using dense_strided_layout_types = mp::mp_list<tt::RowMajor, tt::ColMajor>;
+using blocked_layout_types =
+    mp::mp_push_back<tiled_layout_types, tt::TiledFaces>;
+using layout_types =
+    mp::mp_append<strided_layout_types, blocked_layout_types>;
+
+inline constexpr std::size_t max_rank = 8;
+
+template <class TLayout>
+inline constexpr std::size_t layout_index_v =
+    mp::mp_find<layout_types, TLayout>::value;
+
+template <class TLayout>
+inline constexpr bool is_strided_layout_v =
+    mp::mp_contains<strided_layout_types, TLayout>::value;
+
+inline auto is_strided_layout(std::size_t layout) noexcept -> bool {
+  return layout < mp::mp_size<strided_layout_types>::value;
+}
+
+inline auto size_of(const std::vector<std::size_t> &extents) noexcept
+    -> std::size_t {
+  std::size_t value = 1;
+
+  for (const auto extent : extents) {
+    value *= extent;
+  }
+
+  return value;
+}
+
+// tensor whose dtype, extents and layout are only known at runtime, so that
+// the bindings register a single class and instantiate the templated
+// operators per dtype rather than per tensor type
+struct any_tensor {
+  tt::dtype dtype;
+  // index into layout_types
+  std::size_t layout;
+  // first element, owned as the std::shared_ptr<T[]> of a tt::Tensor
+  std::shared_ptr<void> data;
+  std::vector<std::size_t> extents;
+  // in elements, for layouts with a stride per extent, and empty otherwise
+  std::vector<std::size_t> strides;
+
+  auto rank() const noexcept -> std::size_t { return extents.size(); }
+
+  auto size() const noexcept -> std::size_t { return size_of(extents); }
+};
+
+template <class TCallback>
+auto visit_dtype(tt::dtype dtype, TCallback callback) {
+  return mp::mp_with_index<mp::mp_size<element_types>>(
+      static_cast<std::size_t>(dtype), [&](auto index) {
+        using element_type = mp::mp_at<element_types, decltype(index)>;
+        static_assert(tt::value_v<tt::dtypes, element_type> ==
+                      static_cast<tt::dtype>(index()));
+
+        return callback(mp::mp_identity<element_type>{});
+      });
+}
+
+// dispatches a layout known to be one of TLayouts, a contiguous run of
+// layout_types
+template <class TLayouts = layout_types, class TCallback>
+auto visit_layout(std::size_t layout, TCallback callback) {
+  constexpr auto first =
+      mp::mp_find<layout_types, mp::mp_front<TLayouts>>::value;
+
+  return mp::mp_with_index<mp::mp_size<TLayouts>>(
+      layout - first, [&](auto index) {
+        using layout_type = mp::mp_at<TLayouts, decltype(index)>;
+
+        return callback(mp::mp_identity<layout_type>{});
+      });
+}
+
+template <class TCallback>
+auto visit_rank(std::size_t rank, TCallback callback) {
+  if (rank > max_rank) {
+    throw std::invalid_argument(
+        fmt::format("rank {} not supported; must be at most {}", rank,
+                    max_rank));
+  }
+
+  return mp::mp_with_index<max_rank + 1>(rank, callback);
+}
+
+inline auto row_major_strides(const std::vector<std::size_t> &extents)
+    -> std::vector<std::size_t> {
+  std::vector<std::size_t> strides(extents.size());
+  std::size_t stride = 1;
+
+  for (auto r = extents.size(); r-- > 0;) {
+    strides[r] = stride;
+    stride *= extents[r];
+  }
+
+  return strides;
+}
+
+inline auto col_major_strides(const std::vector<std::size_t> &extents)
+    -> std::vector<std::size_t> {
+  std::vector<std::size_t> strides(extents.size());
+  std::size_t stride = 1;
+
+  for (std::size_t r = 0; r < extents.size(); ++r) {
+    strides[r] = stride;
+    stride *= extents[r];
+  }
+
+  return strides;
+}
+
+// rows and columns of the innermost matrices and how many of them there are;
+// row-major and tiled mappings order the matrices the same way for any rank
+inline auto matrix_extents(const std::vector<std::size_t> &extents)
+    -> std::array<std::size_t, 3> {
+  const auto rank = extents.size();
+  std::size_t matrices = 1;
+
+  for (std::size_t r = 0; r + 2 < rank; ++r) {
+    matrices *= extents[r];
+  }
+
+  return {
+      matrices,
+      rank >= 2 ? extents[rank - 2] : 1,
+      rank >= 1 ? extents[rank - 1] : 1,
+  };
+}
+
+template <class T>
+auto data_of(const any_tensor &input) -> std::shared_ptr<T[]> {
+  return {input.data, static_cast<T *>(input.data.get())};
+}
+
+template <class TTensor>
+auto from_tensor(const TTensor &tensor) -> any_tensor {
+  using layout_type = tt::layout_type_t<TTensor>;
+
+  any_tensor output{
+      tt::value_v<tt::dtypes, tt::element_type_t<TTensor>>,
+      layout_index_v<layout_type>,
+      tensor.data_handle(),
+      std::vector<std::size_t>(TTensor::rank()),
+      {},
+  };
+
+  for (std::size_t r = 0; r < TTensor::rank(); ++r) {
+    output.extents[r] = tensor.extent(r);
+  }
+
+  if constexpr (is_strided_layout_v<layout_type>) {
+    output.strides.resize(TTensor::rank());
+
+    for (std::size_t r = 0; r < TTensor::rank(); ++r) {
+      output.strides[r] = tensor.stride(r);
+    }
+  }
+
+  return output;
+}
+
+template <class T, std::size_t Rank>
+auto as_strided(const any_tensor &input)
+    -> tt::Tensor<T, tt::dims<Rank>, tt::Strided> {
+  using extents_type = tt::dims<Rank>;
+  using mapping_type = tt::Strided::mapping<extents_type>;
+
+  std::array<std::size_t, Rank> extents{};
+  std::array<std::size_t, Rank> strides{};
+
+  for (std::size_t r = 0; r < Rank; ++r) {
+    extents[r] = input.extents[r];
+    strides[r] = input.strides[r];
+  }
+
+  return {data_of<T>(input), mapping_type{extents_type{extents}, strides}};
+}
+
+// views a row-major or tiled tensor as a batch of matrices
+template <class T, class TLayout>
+auto as_matrices(const any_tensor &input)
+    -> tt::Tensor<T, tt::dims<3>, TLayout> {
+  using extents_type = tt::dims<3>;
+  using mapping_type = typename TLayout::template mapping<extents_type>;
+
+  return {data_of<T>(input),
+          mapping_type{extents_type{matrix_extents(input.extents)}}};
+}
+
+// views a row-major, column-major or tiled tensor of rank 2 as a matrix of
+// TLayout
+template <class T, class TLayout>
+auto as_matrix(const any_tensor &input) -> tt::Tensor<T, tt::dims<2>, TLayout> {
+  using extents_type = tt::dims<2>;
+  using mapping_type = typename TLayout::template mapping<extents_type>;
+
+  return {data_of<T>(input),
+          mapping_type{extents_type{input.extents[0], input.extents[1]}}};
+}
+
+// views the buffer of a row-major tensor as a vector of all its elements
+template <class T>
+auto as_flat(const any_tensor &input)
+    -> tt::Tensor<T, tt::dims<1>, tt::RowMajor> {
+  using extents_type = tt::dims<1>;
+  using mapping_type = tt::RowMajor::mapping<extents_type>;
+
+  return {data_of<T>(input), mapping_type{extents_type{input.size()}}};
+}
+
+// throws unless an operator can write its result, of the dtype, extents and
+// layout it would otherwise allocate, into out
+inline auto check_out(const any_tensor &out, tt::dtype dtype,
+                      const std::vector<std::size_t> &extents,
+                      std::size_t layout) -> void {
+  if (out.dtype != dtype) {
+    throw std::invalid_argument(
+        fmt::format("expected out of dtype {}; got {}",
+                    magic_enum::enum_name(dtype),
+                    magic_enum::enum_name(out.dtype)));
+  }
+
+  if (out.extents != extents) {
+    throw std::invalid_argument(
+        fmt::format("expected out of extents ({}); got ({})",
+                    fmt::join(extents, ", "), fmt::join(out.extents, ", ")));
+  }
+
+  if (out.layout != layout) {
+    throw std::invalid_argument(
+        "expected out of the layout the operator returns");
+  }
+
+  if (tt::get_layout_cache().holds(out.data)) {
+    throw std::invalid_argument(
+        "out is shared by the layout cache; copy it or call "
+        "clear_layout_cache() first");
+  }
+}
+
+inline auto required_span_size(std::size_t layout,
+                               const std::vector<std::size_t> &extents)
+    -> std::size_t {
+  return visit_layout(layout, [&](auto identity) -> std::size_t {
+    using layout_type = typename decltype(identity)::type;
+
+    if constexpr (is_strided_layout_v<layout_type>) {
+      return size_of(extents);
+    } else {
+      using extents_type = tt::dims<3>;
+      using mapping_type =
+          typename layout_type::template mapping<extents_type>;
+
+      return mapping_type{extents_type{matrix_extents(extents)}}
+          .required_span_size();
+    }
+  });
+}
+
+// converts between row-major and tiled layouts a batch of matrices at a time,
+// which row-major and tiled mappings store in the same order for any rank
+template <class T, class TInputLayout, class TOutputLayout>
+auto matrices_to_layout(const any_tensor &input) -> any_tensor {
+  auto output = from_tensor(as_matrices<T, TInputLayout>(input) |
+                            tt::to_layout_view<TOutputLayout>{});
+
+  output.extents = input.extents;
+  output.strides = is_strided_layout_v<TOutputLayout>
+                       ? row_major_strides(input.extents)
+                       : std::vector<std::size_t>{};
+
+  return output;
+}
+
+// whether to_layout() converts between the layouts through row-major, which
+// it does between a blocked layout and a strided one other than row-major to
+// bound the kernels instantiated per dtype; blocked layouts convert to each
+// other tile by tile
+inline auto converts_through_row_major(std::size_t input, std::size_t output)
+    -> bool {
+  constexpr auto row_major = layout_index_v<tt::RowMajor>;
+
+  return is_strided_layout(input) != is_strided_layout(output) and
+         input != row_major and output != row_major;
+}
+
+// copies into a new tensor of another layout with the same extents, or shares
+// the input if it has the layout already; strided layouts convert at their own
+// rank, blocked layouts to each other and to row-major, and the rest through
+// row-major
+inline auto to_layout(const any_tensor &input, std::size_t layout)
+    -> any_tensor {
+  constexpr auto row_major = layout_index_v<tt::RowMajor>;
+
+  if (layout == layout_index_v<tt::Strided>) {
+    throw std::invalid_argument("cannot convert to a strided layout");
+  }
+
+  if (layout == input.layout) {
+    return input;
+  }
+
+  if (converts_through_row_major(input.layout, layout)) {
+    return to_layout(to_layout(input, row_major), layout);
+  }
+
+  const auto input_blocked = not is_strided_layout(input.layout);
+  const auto output_blocked = not is_strided_layout(layout);
+
+  return visit_dtype(input.dtype, [&](auto element) {
+    using element_type = typename decltype(element)::type;
+
+    if (input_blocked and output_blocked) {
+      return visit_layout<blocked_layout_types>(
+          input.layout, [&](auto input_layout) {
+            using input_layout_type = typename decltype(input_layout)::type;
+
+            return visit_layout<blocked_layout_types>(
+                layout, [&](auto output_layout) {
+                  using output_layout_type =
+                      typename decltype(output_layout)::type;
+
+                  return matrices_to_layout<element_type, input_layout_type,
+                                            output_layout_type>(input);
+                });
+          });
+    }
+
+    if (input_blocked) {
+      return visit_layout<blocked_layout_types>(
+          input.layout, [&](auto input_layout) {
+            using input_layout_type = typename decltype(input_layout)::type;
+
+            return matrices_to_layout<element_type, input_layout_type,
+                                      tt::RowMajor>(input);
+          });
+    }
+
+    if (output_blocked) {
+      return visit_layout<blocked_layout_types>(
+          layout, [&](auto output_layout) {
+            using output_layout_type = typename decltype(output_layout)::type;
+
+            return matrices_to_layout<element_type, tt::RowMajor,
+                                      output_layout_type>(input);
+          });
+    }
+
+    return visit_layout<dense_strided_layout_types>(
+        layout, [&](auto output_layout) {
+          using output_layout_type = typename decltype(output_layout)::type;
+
+          return visit_rank(input.rank(), [&](auto rank) {
+            return from_tensor(as_strided<element_type, rank>(input) |
+                               tt::to_layout_view<output_layout_type>{});
+          });
+        });
+  });
+}
+
+// copies into an existing tensor of the same dtype and extents in any layout,
+// routing through row-major as to_layout() does
+inline auto to_layout_into(const any_tensor &input, const any_tensor &out)
+    -> any_tensor {
+  constexpr auto row_major = layout_index_v<tt::RowMajor>;
+
+  check_out(out, input.dtype, input.extents, out.layout);
+
+  if (out.data == input.data) {
+    throw std::invalid_argument("out must not share the buffer of the input");
+  }
+
+  if (converts_through_row_major(input.layout, out.layout)) {
+    return to_layout_into(to_layout(input, row_major), out);
+  }
+
+  const auto input_blocked = not is_strided_layout(input.layout);
+  const auto output_blocked = not is_strided_layout(out.layout);
+
+  visit_dtype(input.dtype, [&](auto element) {
+    using element_type = typename decltype(element)::type;
+
+    if (input_blocked and output_blocked) {
+      visit_layout<blocked_layout_types>(input.layout, [&](auto input_layout) {
+        using input_layout_type = typename decltype(input_layout)::type;
+
+        visit_layout<blocked_layout_types>(
+            out.layout, [&](auto output_layout) {
+              using output_layout_type = typename decltype(output_layout)::type;
+
+              tt::to_layout_out(
+                  as_matrices<element_type, output_layout_type>(out),
+                  as_matrices<element_type, input_layout_type>(input));
+            });
+      });
+    } else if (input_blocked) {
+      visit_layout<blocked_layout_types>(input.layout, [&](auto input_layout) {
+        using input_layout_type = typename decltype(input_layout)::type;
+
+        tt::to_layout_out(as_matrices<element_type, tt::RowMajor>(out),
+                          as_matrices<element_type, input_layout_type>(input));
+      });
+    } else if (output_blocked) {
+      visit_layout<blocked_layout_types>(out.layout, [&](auto output_layout) {
+        using output_layout_type = typename decltype(output_layout)::type;
+
+        tt::to_layout_out(as_matrices<element_type, output_layout_type>(out),
+                          as_matrices<element_type, tt::RowMajor>(input));
+      });
+    } else {
+      visit_rank(input.rank(), [&](auto rank) {
+        tt::to_layout_out(as_strided<element_type, rank>(out),
+                          as_strided<element_type, rank>(input));
+      });
+    }
+  });
+
+  return out;
+}
+
+// refuses to reorder the buffer of a tensor in place while other tensors,
+// such as the copies held by calls running on other threads, share it
+inline auto check_unshared(const any_tensor &tensor) -> void {
+  if (tensor.data.use_count() > 1) {
+    throw std::invalid_argument(
+        "cannot convert a tensor in place while other tensors share its "
+        "buffer; use to_layout()");
+  }
+}
+
+// reorders a row-major or tiled tensor into another of those layouts within
+// its own buffer, which both layouts must span exactly, and returns the tensor
+// in its new layout; the input and other tensors sharing the buffer are left
+// with elements in an order they do not expect
+inline auto to_layout_inplace(const any_tensor &input, std::size_t layout)
+    -> any_tensor {
+  constexpr auto row_major = layout_index_v<tt::RowMajor>;
+
+  const auto input_blocked = not is_strided_layout(input.layout);
+  const auto output_blocked = not is_strided_layout(layout);
+
+  if ((not input_blocked and input.layout != row_major) or
+      (not output_blocked and layout != row_major)) {
+    throw std::invalid_argument(
+        "cannot convert in place between layouts other than row-major and "
+        "tiled ones; use to_layout()");
+  }
+
+  if (input.rank() < 2) {
+    throw std::invalid_argument(fmt::format(
+        "cannot convert a tensor of rank {} in place", input.rank()));
+  }
+
+  if (layout == input.layout) {
+    return input;
+  }
+
+  if (input_blocked and output_blocked) {
+    return to_layout_inplace(to_layout_inplace(input, row_major), layout);
+  }
+
+  const auto blocked = input_blocked ? input.layout : layout;
+
+  if (required_span_size(blocked, input.extents) != input.size()) {
+    throw std::invalid_argument(fmt::format(
+        "cannot convert extents ({}) in place; they are not whole tiles",
+        fmt::join(input.extents, ", ")));
+  }
+
+  visit_dtype(input.dtype, [&](auto element) {
+    using element_type = typename decltype(element)::type;
+
+    visit_layout<blocked_layout_types>(blocked, [&](auto blocked_layout) {
+      using blocked_layout_type = typename decltype(blocked_layout)::type;
+
+      if (input_blocked) {
+        tt::to_layout_<tt::RowMajor>(
+            as_matrices<element_type, blocked_layout_type>(input));
+      } else {
+        tt::to_layout_<blocked_layout_type>(
+            as_matrices<element_type, tt::RowMajor>(input));
+      }
+    });
+  });
+
+  auto output = input;
+
+  output.layout = layout;
+  output.strides = output_blocked ? std::vector<std::size_t>{}
+                                  : row_major_strides(input.extents);
+
+  return output;
+}
+
+// views a flat row-major tensor with extents of the same size
+inline auto with_extents(any_tensor input, std::vector<std::size_t> extents)
+    -> any_tensor {
+  input.strides = row_major_strides(extents);
+  input.extents = std::move(extents);
+
+  return input;
+}
+
+// keeps the buffer and the layout of the input for new extents, which must
+// not span more elements than the buffer holds
+inline auto reshape(const any_tensor &input,
+                    const std::vector<std::size_t> &extents) -> any_tensor {
+  if (input.layout == layout_index_v<tt::Strided>) {
+    throw std::invalid_argument(
+        "cannot reshape a strided view; convert it with to_row_major() first");
+  }
+
+  if (required_span_size(input.layout, extents) >
+      required_span_size(input.layout, input.extents)) {
+    throw std::invalid_argument(
+        fmt::format("cannot reshape {} elements into extents {}",
+                    input.size(), fmt::join(extents, ", ")));
+  }
+
+  auto output = input;
+
+  output.extents = extents;
+
+  if (input.layout == layout_index_v<tt::RowMajor>) {
+    output.strides = row_major_strides(extents);
+  } else if (input.layout == layout_index_v<tt::ColMajor>) {
+    output.strides = col_major_strides(extents);
+  }
+
+  return output;
+}
+
+// strided view of the input whose r-th extent is extent axes[r] of the input
+inline auto permute(const any_tensor &input,
+                    const std::vector<std::size_t> &axes) -> any_tensor {
+  if (not is_strided_layout(input.layout)) {
+    throw std::invalid_argument(
+        "cannot permute a tiled tensor; convert it with to_row_major() first");
+  }
+
+  if (axes.size() != input.rank()) {
+    throw std::invalid_argument(fmt::format(
+        "expected {} axes; got {}", input.rank(), axes.size()));
+  }
+
+  auto output = input;
+  std::vector<bool> seen(axes.size());
+
+  output.layout = layout_index_v<tt::Strided>;
+
+  for (std::size_t r = 0; r < axes.size(); ++r) {
+    const auto axis = axes[r];
+
+    if (axis >= axes.size() or seen[axis]) {
+      throw std::invalid_argument(
+          fmt::format("axes ({}) are not a permutation of the extents",
+                      fmt::join(axes, ", ")));
+    }
+
+    seen[axis] = true;
+    output.extents[r] = input.extents[axis];
+    output.strides[r] = input.strides[axis];
+  }
+
+  return output;
+}
+
+inline auto transpose(const any_tensor &input) -> any_tensor {
+  std::vector<std::size_t> axes(input.rank());
+
+  for (std::size_t r = 0; r < axes.size(); ++r) {
+    axes[r] = axes.size() - 1 - r;
+  }
+
+  return permute(input, axes);
+}
+
+inline auto format(const any_tensor &input) -> std::string {
+  if (not is_strided_layout(input.layout)) {
+    return format(to_layout(input, layout_index_v<tt::RowMajor>));
+  }
+
+  return visit_dtype(input.dtype, [&](auto element) {
+    using element_type = typename decltype(element)::type;
+
+    return visit_rank(input.rank(), [&](auto rank) {
+      return fmt::format("{}", as_strided<element_type, rank>(input));
+    });
+  });
+}
+
+// row-major or strided view of a tensor, converting any other layout first
+inline auto as_dense_strided(const any_tensor &input) -> any_tensor {
+  return is_strided_layout(input.layout)
+             ? input
+             : to_layout(input, layout_index_v<tt::RowMajor>);
+}
+
+// product of matrices of the same dtype, read in their own layouts: with the
+// tiled kernel when both are in the same tiled layout, into a column-major
+// result when both are column-major and into a row-major result otherwise;
+// out, if any, must be of the extents and layout of that result
+inline auto matmul(const any_tensor &lhs, const any_tensor &rhs,
+                   const std::optional<any_tensor> &out) -> any_tensor {
+  if (lhs.rank() != 2 or rhs.rank() != 2) {
+    throw std::invalid_argument(
+        fmt::format("expected matrices; got tensors of rank {} and {}",
+                    lhs.rank(), rhs.rank()));
+  }
+
+  if (lhs.extents[1] != rhs.extents[0]) {
+    throw std::invalid_argument(
+        fmt::format("cannot multiply a matrix of {} columns by {} rows",
+                    lhs.extents[1], rhs.extents[0]));
+  }
+
+  if (rhs.dtype != lhs.dtype) {
+    throw std::invalid_argument(
+        fmt::format("expected a tensor of dtype {}; got {}",
+                    magic_enum::enum_name(lhs.dtype),
+                    magic_enum::enum_name(rhs.dtype)));
+  }
+
+  if (out and (out->data == lhs.data or out->data == rhs.data)) {
+    throw std::invalid_argument(
+        "out must not share the buffer of an operand");
+  }
+
+  const std::vector<std::size_t> extents{lhs.extents[0], rhs.extents[1]};
+
+  const auto multiply = [&](const auto &lhs_view, const auto &rhs_view) {
+    using lhs_type = std::decay_t<decltype(lhs_view)>;
+    using rhs_type = std::decay_t<decltype(rhs_view)>;
+    using element_type = tt::element_type_t<lhs_type>;
+    using layout_type = tt::matmul_layout_t<lhs_type, rhs_type>;
+
+    if (not out) {
+      return from_tensor(tt::matmul(lhs_view, rhs_view));
+    }
+
+    check_out(*out, lhs.dtype, extents, layout_index_v<layout_type>);
+    tt::matmul_out(as_matrix<element_type, layout_type>(*out), lhs_view,
+                   rhs_view);
+
+    return *out;
+  };
+
+  return visit_dtype(lhs.dtype, [&](auto element) {
+    using element_type = typename decltype(element)::type;
+
+    // column-major operands keep their layout, like tt::matmul_layout_t
+    if (lhs.layout == layout_index_v<tt::ColMajor> and
+        rhs.layout == layout_index_v<tt::ColMajor>) {
+      return multiply(as_matrix<element_type, tt::ColMajor>(lhs),
+                      as_matrix<element_type, tt::ColMajor>(rhs));
+    }
+
+    // a tiled operand is walked tile by tile against the other in whatever
+    // layout it has, so no pair of layouts is copied first
+    const auto visit_matrix = [&](const any_tensor &input, auto callback) {
+      if (is_strided_layout(input.layout)) {
+        return callback(as_strided<element_type, 2>(input));
+      }
+
+      return visit_layout<blocked_layout_types>(
+          input.layout, [&](auto layout) {
+            using layout_type = typename decltype(layout)::type;
+
+            return callback(as_matrix<element_type, layout_type>(input));
+          });
+    };
+
+    return visit_matrix(lhs, [&](const auto &lhs_view) {
+      return visit_matrix(rhs, [&](const auto &rhs_view) {
+        return multiply(lhs_view, rhs_view);
+      });
+    });
+  });
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "any_tensor.hpp"
+
+#include <tt/operators/transpose.hpp>
+
+#include <optional>
+#include <vector>
+
+// views piped into a tensor, whose layout, extents or axes are only known at
+// runtime like those of the tensor
+struct any_to_layout_view {
+  std::size_t layout;
+  // tensor in the layout to copy into instead of a new one
+  std::optional<any_tensor> out;
+};
+
+struct any_reshape_view {
+  std::vector<std::size_t> extents;
+};
+
+struct any_permute_view {
+  std::vector<std::size_t> axes;
+};
+
+inline auto operator|(const any_tensor &input, const any_to_layout_view &view)
+    -> any_tensor {
+  return view.out ? to_layout_into(input, *view.out)
+                  : to_layout(input, view.layout);
+}
+
+inline auto operator|(const any_tensor &input, const any_reshape_view &view)
+    -> any_tensor {
+  return reshape(input, view.extents);
+}
+
+inline auto operator|(const any_tensor &input, const any_permute_view &view)
+    -> any_tensor {
+  return permute(input, view.axes);
+}
+
+inline auto operator|(const any_tensor &input, const tt::transpose_view &)
+    -> any_tensor {
+  return transpose(input);
+}
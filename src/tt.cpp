@@ -1,15 +1,21 @@
+#include "any_graph.hpp"
+#include "any_sparse.hpp"
+#include "any_tensor.hpp"
+#include "any_views.hpp"
+
 #include <tt/core/dtype.hpp>
-#include <tt/core/float.hpp>
-#include <tt/core/format.hpp>
-#include <tt/core/int.hpp>
 #include <tt/core/layout.hpp>
-#include <tt/core/tensor.hpp>
+#include <tt/core/memory_stats.hpp>
 #include <tt/operators/arange.hpp>
 #include <tt/operators/empty.hpp>
 #include <tt/operators/eye.hpp>
 #include <tt/operators/full.hpp>
-#include <tt/operators/reshape.hpp>
-#include <tt/operators/to_layout.hpp>
+#include <tt/operators/transpose.hpp>
+#include <tt/operators/zeros.hpp>
+#include <tt/runtime/command_queue.hpp>
+#include <tt/runtime/layout_cache.hpp>
+#include <tt/runtime/profiler.hpp>
+#include <tt/runtime/thread_pool.hpp>
 
 #include <boost/mp11.hpp>
 #include <fmt/format.h>
@@ -17,50 +23,17 @@
 #include <nanobind/nanobind.h>
 #include <nanobind/operators.h>
 #include <nanobind/stl/optional.h>
+#include <nanobind/stl/pair.h>
 #include <nanobind/stl/string.h>
 #include <nanobind/stl/variant.h>
+#include <nanobind/stl/vector.h>
 
+#include <atomic>
 #include <memory>
 #include <stdexcept>
-
-constexpr auto name_of(tt::Float32) { return "Float32"; }
-constexpr auto name_of(tt::Float64) { return "Float64"; }
-constexpr auto name_of(tt::BFloat16) { return "BFloat16"; }
-constexpr auto name_of(tt::UInt8) { return "UInt8"; }
-constexpr auto name_of(tt::Int8) { return "Int8"; }
-constexpr auto name_of(tt::Int16) { return "Int16"; }
-constexpr auto name_of(tt::Int32) { return "Int32"; }
-constexpr auto name_of(tt::Int64) { return "Int64"; }
-constexpr auto name_of(tt::Bool) { return "Bool"; }
-
-constexpr auto name_of(tt::dims<0>) { return "Scalar"; }
-constexpr auto name_of(tt::dims<1>) { return "Vector"; }
-constexpr auto name_of(tt::dims<2>) { return "Matrix"; }
-
-template <std::size_t... Extents,
-          class = std::enable_if_t<(... and (Extents == std::dynamic_extent))>>
-auto name_of(std::extents<std::size_t, Extents...>) {
-  static const auto name = fmt::format("Tensor{}D", sizeof...(Extents));
-  return name.c_str();
-}
-
-constexpr auto name_of(tt::RowMajor) { return "RowMajor"; }
-constexpr auto name_of(tt::Tiled) { return "Tiled"; }
-
-template <class TLayout>
-auto name_of(tt::to_layout_view<TLayout>) {
-  static const auto name = fmt::format("To{}View", name_of(TLayout{}));
-  return name.c_str();
-}
-
-template <class TExtents>
-auto name_of(tt::reshape_view<TExtents>) {
-  static const auto name = fmt::format("To{}View", name_of(TExtents{}));
-  return name.c_str();
-}
+#include <vector>
 
 namespace py = nanobind;
-namespace mp = boost::mp11;
 
 template <class TEnum, class = std::enable_if_t<std::is_enum_v<TEnum>>>
 constexpr auto bind_enum(const py::handle &handle) -> void {
@@ -77,84 +50,564 @@ constexpr auto bind_enum(const py::handle &handle) -> void {
   }
 }
 
-template <class TCallback, std::size_t... Is>
-constexpr auto apply_extents(const py::args &extents, TCallback callback,
-                             std::index_sequence<Is...>) {
-  return callback(py::cast<std::size_t>(extents[Is])...);
+// python object shared with commands, released under the gil on any thread
+using shared_object = std::shared_ptr<py::object>;
+using pending_object = tt::pending<shared_object>;
+
+auto share(py::object object) -> shared_object {
+  return {new py::object(std::move(object)), [](py::object *object) {
+            py::gil_scoped_acquire gil;
+            delete object;
+          }};
+}
+
+// command queue owned by python, which must not hold the gil while it joins a
+// command that is waiting to acquire it
+struct command_queue_handle {
+  std::unique_ptr<tt::command_queue> queue =
+      std::make_unique<tt::command_queue>();
+
+  ~command_queue_handle() {
+    py::gil_scoped_release release;
+    queue.reset();
+  }
+
+  // enqueues function(*args, **kwargs), where each pending argument is
+  // replaced by its value once ready; the gil is only held to call function
+  auto enqueue(py::object function, py::tuple args, py::dict kwargs)
+      -> pending_object {
+    std::vector<pending_object> dependencies;
+
+    const auto depend = [&](const py::handle &arg) {
+      if (py::isinstance<pending_object>(arg)) {
+        dependencies.push_back(py::cast<pending_object>(arg));
+      }
+    };
+
+    for (const auto arg : args) {
+      depend(arg);
+    }
+
+    for (const auto [name, arg] : kwargs) {
+      depend(arg);
+    }
+
+    const auto shared_function = share(std::move(function));
+    const auto shared_args = share(std::move(args));
+    const auto shared_kwargs = share(std::move(kwargs));
+
+    return queue->enqueue([=]() -> shared_object {
+      for (const auto &dependency : dependencies) {
+        dependency.wait();
+      }
+
+      py::gil_scoped_acquire gil;
+
+      const auto resolve = [](const py::handle &arg) -> py::object {
+        if (py::isinstance<pending_object>(arg)) {
+          return *py::cast<const pending_object &>(arg).get();
+        }
+
+        return py::borrow(arg);
+      };
+
+      py::list resolved_args;
+      py::dict resolved_kwargs;
+
+      for (const auto arg : py::borrow<py::tuple>(*shared_args)) {
+        resolved_args.append(resolve(arg));
+      }
+
+      for (const auto [name, arg] : py::borrow<py::dict>(*shared_kwargs)) {
+        resolved_kwargs[name] = resolve(arg);
+      }
+
+      const auto arguments = py::steal(PyList_AsTuple(resolved_args.ptr()));
+      const auto result = PyObject_Call(
+          shared_function->ptr(), arguments.ptr(), resolved_kwargs.ptr());
+
+      if (result == nullptr) {
+        throw py::python_error();
+      }
+
+      return share(py::steal(result));
+    });
+  }
+
+  auto enqueue(py::object function, py::tuple args) -> pending_object {
+    return this->enqueue(std::move(function), std::move(args), py::dict{});
+  }
+};
+
+// runs callback while other python threads run, so its result must be cast
+// once the gil is held again
+template <class TCallback>
+auto without_gil(TCallback callback) {
+  py::gil_scoped_release release;
+
+  return callback();
+}
+
+// reorders the buffer of a tensor into another layout without the gil, which
+// is held again to assign the layout; refused by check_unshared() while other
+// tensors share the buffer, whose elements would be reordered under them.
+// Bindings that release the gil take their tensors by value, so a call still
+// reading the tensor on another thread holds a copy and refuses the
+// conversion; calls made on the tensor while it converts see it half
+// converted, as with any operator that writes its input
+auto convert_inplace(any_tensor &tensor, std::size_t layout) -> void {
+  check_unshared(tensor);
+
+  const auto input = tensor;
+
+  tensor = without_gil([&] { return to_layout_inplace(input, layout); });
+}
+
+struct any_to_csr_view {};
+struct any_to_coo_view {};
+
+auto operator|(const any_tensor &input, const any_to_csr_view &) -> any_csr {
+  return to_csr(input);
+}
+
+auto operator|(const any_tensor &input, const any_to_coo_view &) -> any_coo {
+  return to_coo(to_csr(input));
+}
+
+auto operator|(const any_coo &input, const any_to_csr_view &) -> any_csr {
+  return to_csr(input);
+}
+
+auto operator|(const any_csr &input, const any_to_coo_view &) -> any_coo {
+  return to_coo(input);
+}
+
+auto operator|(const any_csr &input, const any_to_layout_view &view)
+    -> any_tensor {
+  if (view.out) {
+    return to_layout_into(to_layout(input, layout_index_v<tt::RowMajor>),
+                          *view.out);
+  }
+
+  return to_layout(input, view.layout);
+}
+
+auto operator|(const any_coo &input, const any_to_layout_view &view)
+    -> any_tensor {
+  return to_csr(input) | view;
+}
+
+auto to_layout_view(std::size_t layout, std::optional<any_tensor> out)
+    -> any_to_layout_view {
+  if (out and out->layout != layout) {
+    throw std::invalid_argument("expected out in the layout of the view");
+  }
+
+  return {layout, std::move(out)};
+}
+
+// out of an operator that would otherwise allocate a row-major tensor of the
+// extents, whose dtype it takes unless one is given
+auto check_row_major_out(const any_tensor &out, std::optional<tt::dtype> dtype,
+                         const std::vector<std::size_t> &extents) -> void {
+  check_out(out, dtype.value_or(out.dtype), extents,
+            layout_index_v<tt::RowMajor>);
+}
+
+// views piped into another view capture both into a graph
+template <class TView>
+auto bind_view(const py::handle &handle, const char *name) -> void {
+  py::class_<TView>{handle, name}
+      .def("__repr__", [](const TView &view) { return format_view(view); })
+      .def("__or__", [](const TView &view, any_view next) {
+        return any_graph{{view, std::move(next)}};
+      });
+}
+
+auto to_extents(const py::args &extents) -> std::vector<std::size_t> {
+  if (extents.size() > max_rank) {
+    throw std::range_error(
+        fmt::format("len(extents) {} not supported; must be at most {}",
+                    extents.size(), max_rank));
+  }
+
+  std::vector<std::size_t> output(extents.size());
+
+  for (std::size_t index = 0; index < extents.size(); ++index) {
+    if (not py::isinstance<std::size_t>(extents[index])) {
+      throw py::type_error(py::str("expected extents[{}] to be {}; got {}")
+                               .format(index, py::inst_name(py::cast(index)),
+                                       py::repr(extents[index]))
+                               .c_str());
+    }
+
+    output[index] = py::cast<std::size_t>(extents[index]);
+  }
+
+  return output;
 }
 
 NB_MODULE(_tt, m) {
   bind_enum<tt::dtype>(m);
   bind_enum<tt::layout>(m);
 
-  using element_types =
-      mp::mp_list<tt::Float32, tt::Float64, tt::BFloat16, tt::UInt8, tt::Int8,
-                  tt::Int16, tt::Int32, tt::Int64, tt::Bool>;
-  using extents_types = mp::mp_list<tt::dims<0>, tt::dims<1>, tt::dims<2>,
-                                    tt::dims<3>, tt::dims<4>, tt::dims<5>,
-                                    tt::dims<6>, tt::dims<7>, tt::dims<8>>;
-  using layout_types = mp::mp_list<tt::RowMajor, tt::Tiled>;
-  using tensor_types =
-      mp::mp_product<tt::Tensor, element_types, extents_types, layout_types>;
-  using tensor_identity_types = mp::mp_transform<mp::mp_identity, tensor_types>;
-  using to_layout_view_types =
-      mp::mp_list<tt::to_row_major_view, tt::to_tiled_view>;
-  using reshape_view_types = mp::mp_transform<tt::reshape_view, extents_types>;
-
   auto m_views = m.def_submodule("views");
 
-  mp::mp_for_each<to_layout_view_types>([&](auto to_layout_view) {
-    using to_layout_view_type = decltype(to_layout_view);
+  bind_view<any_to_layout_view>(m_views, "ToLayoutView");
+  bind_view<any_reshape_view>(m_views, "ReshapeView");
+  bind_view<any_permute_view>(m_views, "PermuteView");
+  bind_view<tt::transpose_view>(m_views, "TransposeView");
+  py::class_<any_to_csr_view>{m_views, "ToCsrView"};
+  py::class_<any_to_coo_view>{m_views, "ToCooView"};
+
+  py::class_<any_tensor> c_tensor{m, "Tensor"};
+
+  c_tensor.def_ro("dtype", &any_tensor::dtype)
+      .def_prop_ro("layout",
+                   [](const any_tensor &tensor) {
+                     return visit_layout(tensor.layout, [](auto identity) {
+                       using layout_type = typename decltype(identity)::type;
+
+                       if constexpr (mp::mp_contains<tiled_layout_types,
+                                                     layout_type>::value) {
+                         return tt::layout::Tiled;
+                       } else {
+                         return tt::value_v<tt::layouts, layout_type>;
+                       }
+                     });
+                   })
+      .def_prop_ro("tile",
+                   [](const any_tensor &tensor)
+                       -> std::optional<std::pair<std::size_t, std::size_t>> {
+                     if (is_strided_layout(tensor.layout)) {
+                       return std::nullopt;
+                     }
+
+                     return visit_layout<blocked_layout_types>(
+                         tensor.layout, [](auto identity) {
+                           using layout_type =
+                               typename decltype(identity)::type;
+
+                           return std::pair{layout_type::tile_height,
+                                            layout_type::tile_width};
+                         });
+                   })
+      .def_prop_ro("shape",
+                   [](const any_tensor &tensor) {
+                     return py::steal<py::tuple>(
+                         PyList_AsTuple(py::cast(tensor.extents).ptr()));
+                   })
+      .def_prop_ro("rank", &any_tensor::rank)
+      .def("__repr__",
+           [](any_tensor tensor) {
+             return without_gil([&] { return format(tensor); });
+           })
+      .def("__matmul__",
+           [](any_tensor lhs, any_tensor rhs) {
+             return without_gil(
+                 [&] { return matmul(lhs, rhs, std::nullopt); });
+           })
+      .def(
+          "__or__",
+          [](any_tensor input, const any_to_layout_view &view) {
+            return without_gil([&] { return input | view; });
+          },
+          py::is_operator())
+      .def(py::self | any_reshape_view{})
+      .def(py::self | any_permute_view{})
+      .def(py::self | tt::transpose_view{})
+      .def(
+          "__or__",
+          [](any_tensor input, const any_graph &graph) {
+            return without_gil([&] { return input | graph; });
+          },
+          py::is_operator())
+      .def(
+          "__or__",
+          [](any_tensor input, any_to_csr_view view) {
+            return without_gil([&] { return input | view; });
+          },
+          py::is_operator())
+      .def(
+          "__or__",
+          [](any_tensor input, any_to_coo_view view) {
+            return without_gil([&] { return input | view; });
+          },
+          py::is_operator());
+
+  py::class_<any_graph>{
+      m, "Graph",
+      "Views captured by piping them into each other, which a tensor piped "
+      "into the graph replays with fewer passes and allocations. Only views "
+      "are captured, not operators such as arange() or matmul(), and no view "
+      "is fused into the operators around the graph."}
+      .def("__len__", &any_graph::size)
+      .def("__repr__",
+           [](const any_graph &graph) {
+             return format_graph(graph.captured());
+           })
+      .def("__or__", &any_graph::then)
+      .def(
+          "plan",
+          [](const any_graph &graph, const any_tensor &input) {
+            return any_graph{graph.plan(input)->views};
+          },
+          py::arg("input"))
+      .def(
+          "arena_size",
+          [](const any_graph &graph, const any_tensor &input) {
+            return graph.plan(input)->memory.size;
+          },
+          py::arg("input"));
+
+  m.def("capture", [](const py::args &views) {
+    std::vector<any_view> captured;
+
+    for (const auto view : views) {
+      captured.push_back(py::cast<any_view>(view));
+    }
 
-    py::class_<to_layout_view_type> c_to_layout_view{
-        m_views,
-        name_of(to_layout_view),
-    };
+    return any_graph{std::move(captured)};
   });
 
-  mp::mp_for_each<reshape_view_types>([&](auto reshape_view) {
-    using reshape_view_type = decltype(reshape_view);
+  // sparse matrices, converted from and to tensors by piping them into views
+  // such as to_csr() and to_row_major()
+  const auto shape = [](const auto &matrix) {
+    return std::pair{matrix.rows, matrix.cols};
+  };
 
-    py::class_<reshape_view_type> c_reshape_view{
-        m_views,
-        name_of(reshape_view),
-    };
-  });
+  py::class_<any_csr>{m, "CsrMatrix"}
+      .def_ro("dtype", &any_csr::dtype)
+      .def_prop_ro("shape", shape)
+      .def_prop_ro("nnz", &any_csr::nnz)
+      .def("__repr__",
+           [](const any_csr &matrix) {
+             return format_sparse("CsrMatrix", matrix);
+           })
+      .def("__matmul__",
+           [](const any_csr &lhs, any_tensor rhs) {
+             return without_gil([&] { return matmul(lhs, rhs); });
+           })
+      .def(py::self | any_to_coo_view{},
+           py::call_guard<py::gil_scoped_release>())
+      .def(py::self | any_to_layout_view{},
+           py::call_guard<py::gil_scoped_release>());
+
+  py::class_<any_coo>{m, "CooMatrix"}
+      .def_ro("dtype", &any_coo::dtype)
+      .def_prop_ro("shape", shape)
+      .def_prop_ro("nnz", &any_coo::nnz)
+      .def("__repr__",
+           [](const any_coo &matrix) {
+             return format_sparse("CooMatrix", matrix);
+           })
+      .def("__matmul__",
+           [](const any_coo &lhs, any_tensor rhs) {
+             return without_gil([&] { return matmul(to_csr(lhs), rhs); });
+           })
+      .def(py::self | any_to_csr_view{},
+           py::call_guard<py::gil_scoped_release>())
+      .def(py::self | any_to_layout_view{},
+           py::call_guard<py::gil_scoped_release>());
+
+  m.def("to_csr", [] { return any_to_csr_view{}; });
+
+  m.def("to_coo", [] { return any_to_coo_view{}; });
+
+  // shared by every python thread, which may set it while others read it
+  const auto default_dtype =
+      std::make_shared<std::atomic<tt::dtype>>(tt::dtype::Float32);
+
+  const auto value_or_default = [=](std::optional<tt::dtype> dtype) {
+    return dtype ? *dtype : default_dtype->load();
+  };
 
-  auto m_tensor = m.def_submodule("Tensor");
+  m.def("default_tile_extent", [] { return tt::default_tile_extent; });
 
-  mp::mp_for_each<tensor_identity_types>([&](auto identity) {
-    using tensor_type = typename decltype(identity)::type;
-    using layout_type = tt::layout_type_t<tensor_type>;
-    using element_type = tt::element_type_t<tensor_type>;
-    using extents_type = tt::extents_type_t<tensor_type>;
+  m.def("tile_shapes", [] {
+    std::vector<std::pair<std::size_t, std::size_t>> shapes;
 
-    auto m_layout = m_tensor.def_submodule(name_of(layout_type{}));
-    auto m_element = m_layout.def_submodule(name_of(element_type{}));
-    auto c_tensor = py::class_<tensor_type>{m_element, name_of(extents_type{})};
+    mp::mp_for_each<tiled_layout_types>([&](auto layout) {
+      using layout_type = decltype(layout);
 
-    c_tensor.def("__repr__", [](const tensor_type &tensor) {
-      return fmt::format("{}", tensor);
+      shapes.emplace_back(layout_type::tile_height, layout_type::tile_width);
     });
 
-    mp::mp_for_each<to_layout_view_types>(
-        [&](auto to_layout_view) { c_tensor.def(py::self | to_layout_view); });
+    return shapes;
+  });
+
+  auto m_profiler = m.def_submodule("profiler");
+
+  py::class_<tt::tensor_description>(m_profiler, "TensorDescription")
+      .def_ro("dtype", &tt::tensor_description::dtype)
+      .def_ro("shape", &tt::tensor_description::shape)
+      .def_ro("layout", &tt::tensor_description::layout);
+
+  py::class_<tt::profile_event>(m_profiler, "ProfileEvent")
+      .def_ro("name", &tt::profile_event::name)
+      .def_ro("tensors", &tt::profile_event::tensors)
+      .def_ro("bytes", &tt::profile_event::bytes)
+      .def_ro("start_ns", &tt::profile_event::start)
+      .def_ro("duration_ns", &tt::profile_event::duration)
+      .def_ro("thread", &tt::profile_event::thread);
+
+  m_profiler.def("enable", [] { tt::get_profiler().enable(); });
+
+  m_profiler.def("disable", [] { tt::get_profiler().disable(); });
 
-    mp::mp_for_each<reshape_view_types>(
-        [&](auto reshape_view) { c_tensor.def(py::self | reshape_view); });
+  m_profiler.def("is_enabled", [] { return tt::get_profiler().enabled(); });
+
+  m_profiler.def("clear", [] { tt::get_profiler().clear(); });
+
+  m_profiler.def("events", [] { return tt::get_profiler().events(); });
+
+  m_profiler.def("summary", [] {
+    return tt::profile_summary(tt::get_profiler().events());
   });
 
-  const auto default_dtype = std::make_shared<tt::dtype>(tt::dtype::Float32);
+  m_profiler.def("chrome_trace", [] {
+    return tt::chrome_trace(tt::get_profiler().events());
+  });
 
-  const auto value_or_default = [=](std::optional<tt::dtype> dtype) {
-    return dtype ? *dtype : *default_dtype;
-  };
+  m.def("memory_stats", [] {
+    const auto stats = tt::get_memory_stats();
+    py::dict by_dtype;
+    py::dict by_layout;
 
-  m.def("default_tile_extent", [] { return tt::default_tile_extent; });
+    for (std::size_t index = 0; index < stats.live_bytes_by_dtype.size();
+         ++index) {
+      by_dtype[py::cast(static_cast<tt::dtype>(index))] =
+          stats.live_bytes_by_dtype[index];
+    }
+
+    for (std::size_t index = 0; index < stats.live_bytes_by_layout.size();
+         ++index) {
+      by_layout[py::cast(static_cast<tt::layout>(index))] =
+          stats.live_bytes_by_layout[index];
+    }
+
+    py::dict output;
+
+    output["live_bytes"] = stats.live_bytes;
+    output["peak_bytes"] = stats.peak_bytes;
+    output["allocations"] = stats.allocations;
+    output["live_allocations"] = stats.live_allocations;
+    output["padding_bytes"] = stats.padding_bytes;
+    output["live_bytes_by_dtype"] = by_dtype;
+    output["live_bytes_by_layout"] = by_layout;
+
+    return output;
+  });
+
+  m.def("reset_peak_memory_stats", tt::reset_peak_memory_stats);
+
+  m.def("set_num_threads", tt::set_num_threads, py::arg("num_threads"));
+
+  m.def("get_num_threads", tt::get_num_threads);
+
+  m.def("set_default_dtype",
+        [=](tt::dtype dtype) { default_dtype->store(dtype); });
+
+  m.def("get_default_dtype", [=] { return default_dtype->load(); });
 
-  m.def("set_default_dtype", [=](tt::dtype dtype) { *default_dtype = dtype; });
+  m.def("set_layout_cache_enabled", [](bool enabled) {
+    if (enabled) {
+      tt::get_layout_cache().enable();
+    } else {
+      tt::get_layout_cache().disable();
+    }
+  });
+
+  m.def("is_layout_cache_enabled",
+        [] { return tt::get_layout_cache().enabled(); });
+
+  m.def("clear_layout_cache", [] { tt::get_layout_cache().clear(); });
+
+  py::class_<tt::event>(m, "Event")
+      .def(py::init<>())
+      .def("ready", &tt::event::ready)
+      .def("wait", &tt::event::wait, py::call_guard<py::gil_scoped_release>())
+      .def("complete", [](const tt::event &event) { event.complete(); });
+
+  py::class_<pending_object> c_pending{m, "Pending"};
+
+  c_pending.def("ready", &pending_object::ready)
+      .def("wait", &pending_object::wait,
+           py::call_guard<py::gil_scoped_release>())
+      .def("event", &pending_object::event)
+      .def("get", [](const pending_object &pending) {
+        {
+          py::gil_scoped_release release;
+          pending.wait();
+        }
+
+        return *pending.get();
+      });
+
+  py::class_<command_queue_handle>(m, "CommandQueue")
+      .def(py::init<>())
+      .def(
+          "enqueue",
+          [](command_queue_handle &handle, py::object function,
+             py::args args, py::kwargs kwargs) {
+            return handle.enqueue(std::move(function), std::move(args),
+                                  std::move(kwargs));
+          },
+          py::arg("function"), py::arg("args"), py::arg("kwargs"))
+      .def("record",
+           [](command_queue_handle &handle) { return handle.queue->record(); })
+      .def(
+          "wait",
+          [](command_queue_handle &handle, const tt::event &event) {
+            handle.queue->wait(event);
+          },
+          py::arg("event"))
+      .def(
+          "synchronize",
+          [](command_queue_handle &handle) { handle.queue->synchronize(); },
+          py::call_guard<py::gil_scoped_release>());
+
+  // queue that pending tensors are piped on, owned by the module so that it is
+  // released before the interpreter
+  const py::object default_queue = py::type<command_queue_handle>()();
+
+  m.attr("_default_queue") = default_queue;
+
+  m.def("get_command_queue", [=] { return default_queue; });
+
+  m.def("synchronize", [=] {
+    auto &handle = py::cast<command_queue_handle &>(default_queue);
+    py::gil_scoped_release release;
+
+    handle.queue->synchronize();
+  });
 
-  m.def("get_default_dtype", [=] { return *default_dtype; });
+  // operators applied to pending tensors run on the default queue once their
+  // operands are ready
+  const auto enqueue_operator = [=](const char *name) {
+    return [=](py::object lhs, py::object rhs) -> py::object {
+      const auto function = py::module_::import_("operator").attr(name);
+      auto &handle = py::cast<command_queue_handle &>(default_queue);
+
+      return py::cast(handle.enqueue(function, py::make_tuple(lhs, rhs)));
+    };
+  };
+
+  c_pending
+      .def("__or__",
+           [=](py::object pending, py::object view) -> py::object {
+             // views that pipe their inputs themselves, such as those given
+             // a queue, run there instead
+             if (PyObject_HasAttrString(view.ptr(), "__ror__")) {
+               return py::borrow(Py_NotImplemented);
+             }
+
+             return enqueue_operator("or_")(pending, view);
+           })
+      .def("__matmul__", enqueue_operator("matmul"))
+      .def("__rmatmul__", [=](py::object rhs, py::object lhs) {
+        return enqueue_operator("matmul")(lhs, rhs);
+      });
 
   constexpr auto visit_enum = [](auto value, auto callback) {
     using enum_type = decltype(value);
@@ -167,35 +620,143 @@ NB_MODULE(_tt, m) {
         });
   };
 
+  // views given out copy into it rather than into a new tensor
   m.def(
       "to_layout",
-      [=](tt::layout layout) {
-        return visit_enum(layout, [](auto layout) {
-          return py::cast(tt::to_layout<layout()>());
+      [=](tt::layout layout, std::optional<any_tensor> out) {
+        return visit_enum(layout, [&](auto layout) -> any_to_layout_view {
+          using layout_type = tt::type_t<tt::layouts, layout()>;
+
+          if constexpr (std::is_same_v<layout_type, tt::Strided>) {
+            throw std::invalid_argument(
+                "cannot convert to a strided layout; use permute()");
+          } else {
+            return to_layout_view(layout_index_v<layout_type>,
+                                  std::move(out));
+          }
         });
       },
-      py::arg("layout"));
+      py::arg("layout"), py::kw_only(), py::arg("out") = py::none());
 
-  m.def("to_row_major", tt::to_row_major);
+  m.def(
+      "to_row_major",
+      [](std::optional<any_tensor> out) {
+        return to_layout_view(layout_index_v<tt::RowMajor>, std::move(out));
+      },
+      py::kw_only(), py::arg("out") = py::none());
 
-  m.def("to_tiled", tt::to_tiled);
+  m.def(
+      "to_col_major",
+      [](std::optional<any_tensor> out) {
+        return to_layout_view(layout_index_v<tt::ColMajor>, std::move(out));
+      },
+      py::kw_only(), py::arg("out") = py::none());
+
+  m.def(
+      "to_tiled_faces",
+      [](std::optional<any_tensor> out) {
+        return to_layout_view(layout_index_v<tt::TiledFaces>, std::move(out));
+      },
+      py::kw_only(), py::arg("out") = py::none());
+
+  const auto to_tiled =
+      [](std::optional<std::pair<std::size_t, std::size_t>> tile,
+         std::optional<any_tensor> out) {
+        constexpr std::pair default_tile{tt::default_tile_extent,
+                                         tt::default_tile_extent};
+        const auto shape = tile.value_or(default_tile);
+        std::optional<any_to_layout_view> view;
+
+        mp::mp_for_each<tiled_layout_types>([&](auto layout) {
+          using layout_type = decltype(layout);
+
+          if (layout_type::tile_height == shape.first and
+              layout_type::tile_width == shape.second) {
+            view = to_layout_view(layout_index_v<layout_type>, out);
+          }
+        });
+
+        if (not view) {
+          throw py::value_error(
+              fmt::format("tile ({}, {}) not supported; see tile_shapes()",
+                          shape.first, shape.second)
+                  .c_str());
+        }
+
+        return *view;
+      };
+
+  m.def("to_tiled", to_tiled, py::kw_only(), py::arg("tile") = py::none(),
+        py::arg("out") = py::none());
+
+  // in-place counterparts of the layout views, for tensors whose extents are
+  // whole tiles, which reorder the elements within the buffer of the tensor
+  c_tensor
+      .def(
+          "to_layout_",
+          [](any_tensor &tensor, const any_to_layout_view &view) {
+            if (view.out) {
+              throw std::invalid_argument(
+                  "cannot convert in place into out; use to_layout()");
+            }
+
+            convert_inplace(tensor, view.layout);
+          },
+          py::arg("view"))
+      .def("to_row_major_",
+           [](any_tensor &tensor) {
+             convert_inplace(tensor, layout_index_v<tt::RowMajor>);
+           })
+      .def(
+          "to_tiled_",
+          [=](any_tensor &tensor,
+              std::optional<std::pair<std::size_t, std::size_t>> tile) {
+            const auto layout = to_tiled(tile, std::nullopt).layout;
+
+            convert_inplace(tensor, layout);
+          },
+          py::kw_only(), py::arg("tile") = py::none());
 
   using Number = std::variant<tt::Int64, tt::Float64>;
 
   const auto arange = [=](Number start, Number end, Number step,
-                          std::optional<tt::dtype> dtype) {
+                          std::optional<tt::dtype> dtype,
+                          std::optional<any_tensor> out) {
     return std::visit(
         [&](auto... args) {
           const auto arg = [&] {
-            if constexpr ((... and std::is_integral_v<decltype(args)>)) {
+            if (out) {
+              return dtype.value_or(out->dtype);
+            } else if constexpr ((... and
+                                  std::is_integral_v<decltype(args)>)) {
               return dtype.value_or(tt::dtype::Int64);
             } else {
               return value_or_default(dtype);
             }
           }();
 
-          return visit_enum(arg, [&](auto dtype) {
-            return py::cast(tt::arange<dtype()>(args...));
+          if (out) {
+            const std::size_t size = visit_enum(arg, [&](auto dtype) {
+              return tt::lazy::arange<dtype()>(args...).extent(0);
+            });
+
+            check_row_major_out(*out, arg, {size});
+
+            return without_gil([&] {
+              visit_dtype(arg, [&](auto element) {
+                using element_type = typename decltype(element)::type;
+
+                tt::arange_out(as_flat<element_type>(*out), args...);
+              });
+
+              return *out;
+            });
+          }
+
+          return without_gil([&] {
+            return visit_enum(arg, [&](auto dtype) {
+              return from_tensor(tt::arange<dtype()>(args...));
+            });
           });
         },
         start, end, step);
@@ -207,110 +768,178 @@ NB_MODULE(_tt, m) {
   m.def(
       "arange",
       [=](Number end, Number start, Number step,
-          std::optional<tt::dtype> dtype) {
-        return arange(start, end, step, dtype);
+          std::optional<tt::dtype> dtype, std::optional<any_tensor> out) {
+        return arange(start, end, step, dtype, std::move(out));
       },
       py::arg("end"), py::kw_only(), py::arg("start") = default_start,
-      py::arg("step") = default_step, py::arg("dtype") = py::none());
+      py::arg("step") = default_step, py::arg("dtype") = py::none(),
+      py::arg("out") = py::none());
 
   m.def("arange", arange, py::arg("start"), py::arg("end"),
         py::arg("step") = default_step, py::kw_only(),
-        py::arg("dtype") = py::none());
-
-  constexpr auto visit_extents = [](const py::args &extents, auto callback) {
-    using extents_size = mp::mp_size<extents_types>;
-
-    if (extents.size() >= extents_size::value) {
-      throw std::range_error(
-          fmt::format("len(extents) {} not supported; must be less than {}",
-                      extents.size(), extents_size::value));
-    }
-
-    for (std::size_t index = 0; index < extents.size(); ++index) {
-      if (not py::isinstance<std::size_t>(extents[index])) {
-        throw py::type_error(py::str("expected extents[{}] to be {}; got {}")
-                                 .format(index, py::inst_name(py::cast(index)),
-                                         py::repr(extents[index]))
-                                 .c_str());
-      }
-    }
-
-    return mp::mp_with_index<extents_size>(extents.size(), [&](auto rank) {
-      return apply_extents(extents, callback, std::make_index_sequence<rank>{});
-    });
-  };
+        py::arg("dtype") = py::none(), py::arg("out") = py::none());
 
   m.def(
       "reshape",
-      [=](const py::args &extents) {
-        return visit_extents(extents, [](auto... extents) {
-          return py::cast(tt::reshape(extents...));
-        });
+      [](const py::args &extents) {
+        return any_reshape_view{to_extents(extents)};
       },
       py::arg("extents"));
 
-  constexpr auto visit_dtype_and_extents =
-      [=](tt::dtype dtype, const py::args &extents, auto callback) {
-        return visit_enum(dtype, [&](auto dtype) {
-          return visit_extents(extents, [&](auto... extents) {
-            return callback(dtype, extents...);
-          });
+  m.def(
+      "permute",
+      [](const py::args &axes) { return any_permute_view{to_extents(axes)}; },
+      py::arg("axes"));
+
+  m.def("transpose", tt::transpose);
+
+  // fills a flat buffer, which is then viewed with the requested extents;
+  // given out, the creation functions write into its buffer instead
+  const auto full = [=](tt::Float64 fill_value, const py::args &extents,
+                        std::optional<tt::dtype> dtype,
+                        std::optional<any_tensor> out) {
+    auto shape = to_extents(extents);
+
+    if (out) {
+      check_row_major_out(*out, dtype, shape);
+
+      return without_gil([&] {
+        visit_dtype(out->dtype, [&](auto element) {
+          using element_type = typename decltype(element)::type;
+
+          tt::full_out(as_flat<element_type>(*out), fill_value);
         });
-      };
+
+        return *out;
+      });
+    }
+
+    return without_gil([&] {
+      return visit_enum(value_or_default(dtype), [&](auto dtype) {
+        return with_extents(
+            from_tensor(tt::full<dtype()>(fill_value, size_of(shape))),
+            std::move(shape));
+      });
+    });
+  };
 
   const auto bind_with_fill = [=](auto fill_value) {
-    return [=](const py::args &extents, std::optional<tt::dtype> dtype) {
-      return visit_dtype_and_extents(
-          value_or_default(dtype), extents, [&](auto dtype, auto... extents) {
-            return py::cast(tt::full<dtype()>(fill_value, extents...));
-          });
+    return [=](const py::args &extents, std::optional<tt::dtype> dtype,
+               std::optional<any_tensor> out) {
+      return full(fill_value, extents, dtype, std::move(out));
     };
   };
 
+  m.def("full", full, py::arg("fill_value"), py::arg("extents"),
+        py::kw_only(), py::arg("dtype") = py::none(),
+        py::arg("out") = py::none());
+
+  m.def("ones", bind_with_fill(1), py::arg("extents"), py::kw_only(),
+        py::arg("dtype") = py::none(), py::arg("out") = py::none());
+
+  // zeroed lazily by the kernel rather than filled
   m.def(
-      "full",
-      [=](tt::Float64 fill_value, const py::args &extents,
-          std::optional<tt::dtype> dtype) {
-        return visit_dtype_and_extents(
-            value_or_default(dtype), extents, [&](auto dtype, auto... extents) {
-              return py::cast(tt::full<dtype()>(fill_value, extents...));
+      "zeros",
+      [=](const py::args &extents, std::optional<tt::dtype> dtype,
+          std::optional<any_tensor> out) {
+        auto shape = to_extents(extents);
+
+        if (out) {
+          check_row_major_out(*out, dtype, shape);
+
+          return without_gil([&] {
+            visit_dtype(out->dtype, [&](auto element) {
+              using element_type = typename decltype(element)::type;
+
+              tt::zeros_out(as_flat<element_type>(*out));
             });
-      },
-      py::arg("fill_value"), py::arg("extents"), py::kw_only(),
-      py::arg("dtype") = py::none());
 
-  m.def("ones", bind_with_fill(1), py::arg("extents"), py::kw_only(),
-        py::arg("dtype") = py::none());
+            return *out;
+          });
+        }
 
-  m.def("zeros", bind_with_fill(0), py::arg("extents"), py::kw_only(),
-        py::arg("dtype") = py::none());
+        return without_gil([&] {
+          return visit_enum(value_or_default(dtype), [&](auto dtype) {
+            return with_extents(
+                from_tensor(tt::zeros<dtype()>(size_of(shape))),
+                std::move(shape));
+          });
+        });
+      },
+      py::arg("extents"), py::kw_only(), py::arg("dtype") = py::none(),
+      py::arg("out") = py::none());
 
   m.def(
       "empty",
-      [=](const py::args &extents, std::optional<tt::dtype> dtype) {
-        return visit_dtype_and_extents(
-            value_or_default(dtype), extents, [](auto dtype, auto... extents) {
-              return py::cast(tt::empty<dtype()>(extents...));
-            });
+      [=](const py::args &extents, std::optional<tt::dtype> dtype,
+          std::optional<any_tensor> out) {
+        auto shape = to_extents(extents);
+
+        if (out) {
+          check_row_major_out(*out, dtype, shape);
+
+          visit_dtype(out->dtype, [&](auto element) {
+            using element_type = typename decltype(element)::type;
+
+            tt::empty_out(as_flat<element_type>(*out));
+          });
+
+          return *out;
+        }
+
+        return without_gil([&] {
+          return visit_enum(value_or_default(dtype), [&](auto dtype) {
+            return with_extents(
+                from_tensor(tt::empty<dtype()>(size_of(shape))),
+                std::move(shape));
+          });
+        });
       },
-      py::arg("extents"), py::kw_only(), py::arg("dtype") = py::none());
+      py::arg("extents"), py::kw_only(), py::arg("dtype") = py::none(),
+      py::arg("out") = py::none());
+
+  const auto eye = [=](std::size_t rows, std::size_t cols,
+                       std::optional<tt::dtype> dtype,
+                       std::optional<any_tensor> out) {
+    if (out) {
+      check_row_major_out(*out, dtype, {rows, cols});
+
+      return without_gil([&] {
+        visit_dtype(out->dtype, [&](auto element) {
+          using element_type = typename decltype(element)::type;
+
+          tt::eye_out(as_matrix<element_type, tt::RowMajor>(*out));
+        });
+
+        return *out;
+      });
+    }
+
+    return without_gil([&] {
+      return visit_enum(value_or_default(dtype), [&](auto dtype) {
+        return from_tensor(tt::eye<dtype()>(rows, cols));
+      });
+    });
+  };
 
   m.def(
       "eye",
-      [=](std::size_t extent, std::optional<tt::dtype> dtype) {
-        return visit_enum(value_or_default(dtype), [&](auto dtype) {
-          return py::cast(tt::eye<dtype()>(extent));
-        });
+      [=](std::size_t extent, std::optional<tt::dtype> dtype,
+          std::optional<any_tensor> out) {
+        return eye(extent, extent, dtype, std::move(out));
       },
-      py::arg("extent"), py::kw_only(), py::arg("dtype") = py::none());
+      py::arg("extent"), py::kw_only(), py::arg("dtype") = py::none(),
+      py::arg("out") = py::none());
 
+  m.def("eye", eye, py::arg("rows"), py::arg("cols"), py::kw_only(),
+        py::arg("dtype") = py::none(), py::arg("out") = py::none());
+
+  // products of dense matrices, written into out if given
   m.def(
-      "eye",
-      [=](std::size_t rows, std::size_t cols, std::optional<tt::dtype> dtype) {
-        return visit_enum(value_or_default(dtype), [&](auto dtype) {
-          return py::cast(tt::eye<dtype()>(rows, cols));
-        });
+      "matmul",
+      [](any_tensor lhs, any_tensor rhs, std::optional<any_tensor> out) {
+        return without_gil([&] { return matmul(lhs, rhs, out); });
       },
-      py::arg("rows"), py::arg("cols"), py::kw_only(),
-      py::arg("dtype") = py::none());
+      py::arg("lhs"), py::arg("rhs"), py::kw_only(),
+      py::arg("out") = py::none());
 }
@@ -1,19 +1,66 @@
+import atexit
+
 from ._tt import (
     dtype,
     layout,
     views,
     Tensor,
+    Graph,
+    CsrMatrix,
+    CooMatrix,
     default_tile_extent,
+    tile_shapes,
+    memory_stats,
+    reset_peak_memory_stats,
+    set_num_threads,
+    get_num_threads,
+    Event,
+    Pending,
+    CommandQueue,
+    get_command_queue,
+    synchronize,
     set_default_dtype,
     get_default_dtype,
+    set_layout_cache_enabled,
+    is_layout_cache_enabled,
+    clear_layout_cache,
     to_layout,
     to_row_major,
+    to_col_major,
     to_tiled,
+    to_tiled_faces,
+    to_csr,
+    to_coo,
+    capture,
     arange,
     reshape,
+    permute,
+    transpose,
     full,
     ones,
     zeros,
     empty,
     eye,
+    matmul,
 )
+
+from . import profiler
+from .commands import queued, queued_view
+
+# operators run on a command queue when given queue= or a pending argument,
+# returning a Pending; views given queue= pipe their inputs on it
+arange = queued(arange)
+full = queued(full)
+ones = queued(ones)
+zeros = queued(zeros)
+empty = queued(empty)
+eye = queued(eye)
+matmul = queued(matmul)
+to_layout = queued_view(to_layout)
+to_row_major = queued_view(to_row_major)
+to_col_major = queued_view(to_col_major)
+to_tiled = queued_view(to_tiled)
+to_tiled_faces = queued_view(to_tiled_faces)
+
+# commands still queued at exit need the interpreter to run
+atexit.register(synchronize)
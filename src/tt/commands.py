@@ -0,0 +1,47 @@
+import operator
+from functools import wraps
+
+from ._tt import Pending, get_command_queue
+
+
+def queued(function):
+    # runs function on the queue given as queue=, or on the default queue when
+    # an argument is pending, once the pending arguments are ready, returning
+    # a Pending of its result; otherwise runs it right away
+    @wraps(function)
+    def wrapper(*args, queue=None, **kwargs):
+        if queue is None:
+            values = (*args, *kwargs.values())
+
+            if not any(isinstance(value, Pending) for value in values):
+                return function(*args, **kwargs)
+
+            queue = get_command_queue()
+
+        return queue.enqueue(function, *args, **kwargs)
+
+    return wrapper
+
+
+class QueuedView:
+    # view whose inputs, tensors or pending ones, are piped into it on a queue
+    def __init__(self, view, queue):
+        self.view = view
+        self.queue = queue
+
+    def __ror__(self, input):
+        return self.queue.enqueue(operator.or_, input, self.view)
+
+    def __repr__(self):
+        return f"{self.view!r} on {self.queue!r}"
+
+
+def queued_view(function):
+    # the view of function, piped on the queue given as queue= if any
+    @wraps(function)
+    def wrapper(*args, queue=None, **kwargs):
+        view = function(*args, **kwargs)
+
+        return view if queue is None else QueuedView(view, queue)
+
+    return wrapper
@@ -0,0 +1,30 @@
+from contextlib import contextmanager
+
+from ._tt.profiler import (
+    TensorDescription,
+    ProfileEvent,
+    enable,
+    disable,
+    is_enabled,
+    clear,
+    events,
+    summary,
+    chrome_trace,
+)
+
+
+def export_chrome_trace(path):
+    # open with chrome://tracing or https://ui.perfetto.dev
+    with open(path, "w") as file:
+        file.write(chrome_trace())
+
+
+@contextmanager
+def profile():
+    # records the operators called inside the with block
+    enable()
+
+    try:
+        yield
+    finally:
+        disable()